@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef> // For std::size_t
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#include <x86intrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+// What does layout actually cost at runtime?
+// missaligned-vs-aligned.cpp shows the sizes and offsets; this streams the
+// same structs (plus a packed variant) through a loop, then streams plain
+// doubles starting at misaligned and cache-line-splitting offsets through
+// scalar, SSE2 and AVX2 loops. Reported per run: bandwidth (GB/s), ns per
+// element and TSC cycles per element (x86 only).
+
+// Structure with members ordered to maximize padding
+struct Misaligned {
+  char a;   // 1 byte
+  int b;    // 4 bytes
+  char c;   // 1 byte
+  double d; // 8 bytes
+};
+
+// Structure with members ordered to minimize padding
+struct Aligned {
+  double d; // 8 bytes
+  int b;    // 4 bytes
+  char a;   // 1 byte
+  char c;   // 1 byte
+};
+
+// No padding at all: d sits at offset 6 and elements straddle cache lines
+struct __attribute__((packed)) Packed {
+  char a;   // 1 byte
+  int b;    // 4 bytes
+  char c;   // 1 byte
+  double d; // 8 bytes
+};
+
+// Keep the "scalar" kernel scalar: GCC's SLP pass would otherwise pair the
+// four accumulators into SSE2 adds
+#if defined(__GNUC__) && !defined(__clang__)
+#define SCALAR_ONLY __attribute__((optimize("no-tree-vectorize")))
+#else
+#define SCALAR_ONLY
+#endif
+
+volatile double benchmark_sink;
+
+uint64_t read_cycle_counter() {
+#ifdef HAVE_X86_SIMD
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+struct Result {
+  double seconds;
+  uint64_t cycles;
+};
+
+// Best of several timed runs of fn()
+template <typename Fn> Result measure(Fn &&fn, int repeats) {
+  Result best{1e300, 0};
+  for (int r = 0; r < repeats; ++r) {
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t c0 = read_cycle_counter();
+    benchmark_sink = fn();
+    uint64_t c1 = read_cycle_counter();
+    auto end = std::chrono::high_resolution_clock::now();
+    double s = std::chrono::duration<double>(end - start).count();
+    if (s < best.seconds)
+      best = {s, c1 - c0};
+  }
+  return best;
+}
+
+void print_row(const char *label, const Result &r, std::size_t bytes,
+               std::size_t elements) {
+  double n = static_cast<double>(elements);
+  std::cout << std::left << std::setw(28) << label << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10)
+            << static_cast<double>(bytes) / r.seconds / 1e9 << std::setw(12)
+            << r.seconds * 1e9 / n << std::setw(12);
+  if (r.cycles)
+    std::cout << static_cast<double>(r.cycles) / n;
+  else
+    std::cout << "n/a";
+  std::cout << "\n";
+}
+
+void print_header() {
+  std::cout << std::left << std::setw(28) << "layout / kernel" << std::right
+            << std::setw(10) << "GB/s" << std::setw(12) << "ns/elem"
+            << std::setw(12) << "cyc/elem" << "\n";
+}
+
+// ===== STRUCT LAYOUTS =====
+// Same computation over every field, whatever the layout
+template <typename T> double sum_fields(const T *items, std::size_t count) {
+  double sum = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    sum += items[i].d * items[i].b + items[i].a + items[i].c;
+  }
+  return sum;
+}
+
+template <typename T>
+void bench_struct(const char *label, std::size_t count, int passes) {
+  T *items = static_cast<T *>(
+      std::aligned_alloc(64, (count * sizeof(T) + 63) & ~std::size_t{63}));
+  for (std::size_t i = 0; i < count; ++i) {
+    items[i].a = static_cast<char>(i & 7);
+    items[i].b = static_cast<int>(i & 1023);
+    items[i].c = static_cast<char>(i & 3);
+    items[i].d = 0.5 * static_cast<double>(i & 255);
+  }
+  Result r = measure(
+      [&] {
+        double sum = 0;
+        for (int p = 0; p < passes; ++p)
+          sum += sum_fields(items, count);
+        return sum;
+      },
+      5);
+  print_row(label, r, sizeof(T) * count * passes, count * passes);
+  std::free(items);
+}
+
+// ===== RAW STREAMS AT AN OFFSET =====
+// Doubles starting `offset` bytes past a 64-byte boundary; loads go through
+// memcpy/loadu so misaligned addresses are well defined
+
+// Every kernel keeps four independent accumulators so it is bound by loads,
+// not by floating-point add latency
+SCALAR_ONLY double sum_scalar(const char *base, std::size_t count) {
+  double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  std::size_t i = 0;
+  auto load = [base](std::size_t index) {
+    double v;
+    std::memcpy(&v, base + index * sizeof(double), sizeof(v));
+    return v;
+  };
+  for (; i + 4 <= count; i += 4) {
+    s0 += load(i);
+    s1 += load(i + 1);
+    s2 += load(i + 2);
+    s3 += load(i + 3);
+  }
+  for (; i < count; ++i)
+    s0 += load(i);
+  return (s0 + s1) + (s2 + s3);
+}
+
+#ifdef HAVE_X86_SIMD
+double sum_sse2(const char *base, std::size_t count) {
+  __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+  __m128d a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const double *p = reinterpret_cast<const double *>(base) + i;
+    a0 = _mm_add_pd(a0, _mm_loadu_pd(p));
+    a1 = _mm_add_pd(a1, _mm_loadu_pd(p + 2));
+    a2 = _mm_add_pd(a2, _mm_loadu_pd(p + 4));
+    a3 = _mm_add_pd(a3, _mm_loadu_pd(p + 6));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3)));
+  return lanes[0] + lanes[1] + sum_scalar(base + i * sizeof(double), count - i);
+}
+
+__attribute__((target("avx2"))) double sum_avx2(const char *base,
+                                                  std::size_t count) {
+  __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+  __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const double *p = reinterpret_cast<const double *>(base) + i;
+    a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p));
+    a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + 4));
+    a2 = _mm256_add_pd(a2, _mm256_loadu_pd(p + 8));
+    a3 = _mm256_add_pd(a3, _mm256_loadu_pd(p + 12));
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes,
+                   _mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         sum_scalar(base + i * sizeof(double), count - i);
+}
+#endif
+
+using StreamKernel = double (*)(const char *, std::size_t);
+
+void bench_offsets(const char *title, std::size_t count, int passes) {
+  std::cout << "\n--- " << title << " (" << count * sizeof(double) / 1024
+            << " KB) ---\n";
+  print_header();
+
+  char *buffer =
+      static_cast<char *>(std::aligned_alloc(64, count * sizeof(double) + 128));
+  for (std::size_t i = 0; i < count * sizeof(double) + 128; ++i)
+    buffer[i] = static_cast<char>(i % 61 == 0);
+
+  struct Kernel {
+    const char *name;
+    StreamKernel fn;
+  };
+  Kernel kernels[3] = {{"scalar", sum_scalar}};
+  int kernel_count = 1;
+#ifdef HAVE_X86_SIMD
+  kernels[kernel_count++] = {"sse2", sum_sse2};
+  if (__builtin_cpu_supports("avx2"))
+    kernels[kernel_count++] = {"avx2", sum_avx2};
+#endif
+
+  // 0: aligned for every width. 32: up to AVX2. 16: up to SSE2. 8: scalar
+  // only. 1 and 4: misaligned; every 8th scalar load and a quarter
+  // to a half of the vector loads cross a 64-byte line
+  const std::size_t offsets[] = {0, 8, 16, 32, 1, 4};
+  for (int k = 0; k < kernel_count; ++k) {
+    for (std::size_t offset : offsets) {
+      const char *base = buffer + offset;
+      Result r = measure(
+          [&] {
+            double sum = 0;
+            for (int p = 0; p < passes; ++p)
+              sum += kernels[k].fn(base, count);
+            return sum;
+          },
+          5);
+      char label[64];
+      std::snprintf(label, sizeof(label), "%s, offset %zu", kernels[k].name,
+                    offset);
+      print_row(label, r, count * sizeof(double) * passes, count * passes);
+    }
+  }
+  std::free(buffer);
+}
+
+int main() {
+  std::cout << "=== Aligned vs Misaligned Access Throughput ===\n";
+  std::cout << "sizeof: Misaligned " << sizeof(Misaligned) << ", Aligned "
+            << sizeof(Aligned) << ", Packed " << sizeof(Packed) << " bytes\n";
+#ifdef HAVE_X86_SIMD
+  std::cout << "cyc/elem uses the TSC (constant-rate reference cycles)\n";
+#else
+  std::cout << "No cycle counter on this target; cyc/elem shows n/a\n";
+#endif
+
+  // L1-resident: layout cost shows up as extra loads and line splits.
+  // Memory-resident: layout cost shows up as bytes moved per element
+  const std::size_t SMALL = 1024;
+  const std::size_t LARGE = 4 * 1024 * 1024;
+
+  std::cout << "\n--- Struct arrays, L1-resident (" << SMALL << " elements) ---\n";
+  print_header();
+  bench_struct<Misaligned>("Misaligned (24 B)", SMALL, 20000);
+  bench_struct<Aligned>("Aligned (16 B)", SMALL, 20000);
+  bench_struct<Packed>("Packed (14 B)", SMALL, 20000);
+
+  std::cout << "\n--- Struct arrays, memory-resident (" << LARGE
+            << " elements) ---\n";
+  print_header();
+  bench_struct<Misaligned>("Misaligned (24 B)", LARGE, 4);
+  bench_struct<Aligned>("Aligned (16 B)", LARGE, 4);
+  bench_struct<Packed>("Packed (14 B)", LARGE, 4);
+
+  bench_offsets("Double stream at byte offsets, L1-resident", 2048, 20000);
+  bench_offsets("Double stream at byte offsets, memory-resident",
+                8 * 1024 * 1024, 4);
+
+  std::cout << "\nKey takeaways:\n";
+  std::cout << "- Reordering members shrinks the struct, so fewer bytes move per element\n";
+  std::cout << "- Packing saves more bytes but splits fields across cache lines\n";
+  std::cout << "- Unaligned loads are cheap on current cores; any cost shows in L1-bound SIMD loops\n";
+  std::cout << "- Once memory bandwidth is the limit, bytes per element matter more than alignment\n";
+
+  return 0;
+}
@@ -0,0 +1,421 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include <sys/mman.h>
+
+#include "../common/alloc_result.hpp"
+
+// ===== CHUNK REGISTRY =====
+// One bit per 64KB-aligned address: set while a chunk lives there. A foreign
+// pointer masks down to an address that may not even be mapped, so ownership
+// has to be settled here before any chunk header is read. Two levels of 16
+// bits cover the 32-bit chunk number of a 48-bit address space; leaves are
+// created on demand, so a lookup is two loads and a bit test.
+class ChunkRegistry {
+public:
+    static constexpr unsigned CHUNK_SHIFT = 16;
+
+private:
+    static constexpr unsigned LEVEL_BITS = 16;
+    static constexpr std::size_t LEVEL_SIZE = std::size_t(1) << LEVEL_BITS;
+
+    struct Leaf {
+        uint64_t bits[LEVEL_SIZE / 64];
+    };
+
+    Leaf* root_[LEVEL_SIZE] = {};
+
+    // false for addresses beyond 48 bits, which no chunk can have
+    static bool split(const void* p, std::size_t& i1, std::size_t& i2) {
+        uintptr_t chunk = reinterpret_cast<uintptr_t>(p) >> CHUNK_SHIFT;
+        if (chunk >> (2 * LEVEL_BITS)) return false;
+        i1 = chunk >> LEVEL_BITS;
+        i2 = chunk & (LEVEL_SIZE - 1);
+        return true;
+    }
+
+public:
+    ChunkRegistry() = default;
+
+    ~ChunkRegistry() {
+        for (Leaf* leaf : root_) delete leaf;
+    }
+
+    ChunkRegistry(const ChunkRegistry&) = delete;
+    ChunkRegistry& operator=(const ChunkRegistry&) = delete;
+
+    bool insert(const void* base) {
+        std::size_t i1, i2;
+        if (!split(base, i1, i2)) return false;
+        if (!root_[i1]) {
+            root_[i1] = new (std::nothrow) Leaf{};
+            if (!root_[i1]) return false;
+        }
+        root_[i1]->bits[i2 / 64] |= uint64_t(1) << (i2 % 64);
+        return true;
+    }
+
+    void erase(const void* base) {
+        std::size_t i1, i2;
+        if (split(base, i1, i2) && root_[i1]) {
+            root_[i1]->bits[i2 / 64] &= ~(uint64_t(1) << (i2 % 64));
+        }
+    }
+
+    // Is p anywhere inside a live chunk?
+    bool contains(const void* p) const {
+        std::size_t i1, i2;
+        if (!split(p, i1, i2) || !root_[i1]) return false;
+        return (root_[i1]->bits[i2 / 64] >> (i2 % 64)) & 1;
+    }
+};
+
+// Aligned-chunk pool
+// Every chunk is CHUNK_SIZE bytes and starts at a CHUNK_SIZE-aligned
+// address, with a small header at the front. Masking any block pointer with
+// ~(CHUNK_SIZE - 1) therefore lands on its chunk header, which tells us:
+// - which pool owns the block (O(1) ownership, no bounds scan, once the
+//   registry has confirmed the chunk is live)
+// - the block size (free without being told the size)
+// - how many blocks in that chunk are live (per-chunk accounting, so an
+//   empty chunk can be handed back to the system)
+class AlignedChunkPool {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+    static_assert(CHUNK_SIZE == std::size_t(1) << ChunkRegistry::CHUNK_SHIFT);
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct ChunkHeader {
+        uint32_t live_count;
+        AlignedChunkPool* owner;
+        std::size_t block_size;
+        FreeNode* free_head;        // Per-chunk free list
+        ChunkHeader* prev_partial;  // Chunks with free blocks, doubly linked
+        ChunkHeader* next_partial;
+        bool in_partial_list;
+    };
+
+    static constexpr std::size_t header_bytes() {
+        return (sizeof(ChunkHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    }
+
+    std::size_t block_size_;
+    std::size_t blocks_per_chunk_;
+    ChunkHeader* partial_ = nullptr;  // Chunks that still have free blocks
+    ChunkHeader* spare_ = nullptr;    // One empty chunk kept to avoid thrash
+    std::size_t chunk_count_ = 0;
+    std::size_t live_count_ = 0;
+
+    // Shared by every pool, like chunk_of(); single-threaded, like the pools
+    static ChunkRegistry& registry() {
+        static ChunkRegistry chunks;
+        return chunks;
+    }
+
+    void link_partial(ChunkHeader* chunk) {
+        chunk->prev_partial = nullptr;
+        chunk->next_partial = partial_;
+        if (partial_) partial_->prev_partial = chunk;
+        partial_ = chunk;
+        chunk->in_partial_list = true;
+    }
+
+    void unlink_partial(ChunkHeader* chunk) {
+        if (chunk->prev_partial) chunk->prev_partial->next_partial = chunk->next_partial;
+        else partial_ = chunk->next_partial;
+        if (chunk->next_partial) chunk->next_partial->prev_partial = chunk->prev_partial;
+        chunk->in_partial_list = false;
+    }
+
+    ChunkHeader* new_chunk() {
+        void* memory = std::aligned_alloc(CHUNK_SIZE, CHUNK_SIZE);
+        if (!memory) {
+            throw_bad_alloc();
+        }
+        if (!registry().insert(memory)) {
+            std::free(memory);
+            throw_bad_alloc();
+        }
+        ChunkHeader* chunk = static_cast<ChunkHeader*>(memory);
+        *chunk = ChunkHeader{0, this, block_size_, nullptr, nullptr, nullptr, false};
+
+        // Thread the free list back to front so blocks come out in address order
+        char* first = static_cast<char*>(memory) + header_bytes();
+        for (std::size_t i = blocks_per_chunk_; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(first + (i - 1) * block_size_);
+            node->next = chunk->free_head;
+            chunk->free_head = node;
+        }
+        ++chunk_count_;
+        return chunk;
+    }
+
+    void release_chunk(ChunkHeader* chunk) {
+        registry().erase(chunk);
+        std::free(chunk);
+        --chunk_count_;
+    }
+
+public:
+    explicit AlignedChunkPool(std::size_t block_size) {
+        std::size_t align = alignof(std::max_align_t);
+        block_size_ = ((block_size < sizeof(FreeNode) ? sizeof(FreeNode) : block_size) + align - 1) & ~(align - 1);
+        blocks_per_chunk_ = (CHUNK_SIZE - header_bytes()) / block_size_;
+    }
+
+    ~AlignedChunkPool() {
+        while (partial_) {
+            ChunkHeader* chunk = partial_;
+            unlink_partial(chunk);
+            release_chunk(chunk);
+        }
+        if (spare_) release_chunk(spare_);
+        // Full chunks are only reachable through their blocks; a pool
+        // destroyed with live blocks leaks them, as the other pools would
+    }
+
+    AlignedChunkPool(const AlignedChunkPool&) = delete;
+    AlignedChunkPool& operator=(const AlignedChunkPool&) = delete;
+
+    // Header of the chunk containing p (p must come from an AlignedChunkPool)
+    static ChunkHeader* chunk_of(const void* p) {
+        return reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(p) & ~(CHUNK_SIZE - 1));
+    }
+
+    void* allocate() {
+        if (!partial_) {
+            ChunkHeader* chunk = spare_ ? spare_ : new_chunk();
+            spare_ = nullptr;
+            link_partial(chunk);
+        }
+        ChunkHeader* chunk = partial_;
+        FreeNode* node = chunk->free_head;
+        chunk->free_head = node->next;
+        ++chunk->live_count;
+        ++live_count_;
+        if (!chunk->free_head) {
+            unlink_partial(chunk);  // Now full
+        }
+        return node;
+    }
+
+    void deallocate(void* p) noexcept {
+        ChunkHeader* chunk = chunk_of(p);
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = chunk->free_head;
+        chunk->free_head = node;
+        --chunk->live_count;
+        --live_count_;
+
+        if (!chunk->in_partial_list) {
+            link_partial(chunk);  // Was full, has room again
+        }
+        if (chunk->live_count == 0) {
+            // Keep one empty chunk around; give any other back
+            unlink_partial(chunk);
+            if (spare_) {
+                release_chunk(chunk);
+            } else {
+                spare_ = chunk;
+            }
+        }
+    }
+
+    // O(1) ownership for any pointer at all: the header is only read once
+    // the registry says a chunk lives there
+    bool owns(const void* p) const {
+        if (!registry().contains(p)) return false;
+        uintptr_t offset = reinterpret_cast<uintptr_t>(p) & (CHUNK_SIZE - 1);
+        return offset >= header_bytes() && chunk_of(p)->owner == this;
+    }
+
+    // Free without knowing the pool or the size - the header knows both
+    static void deallocate_any(void* p) noexcept {
+        chunk_of(p)->owner->deallocate(p);
+    }
+
+    static std::size_t block_size_of(const void* p) { return chunk_of(p)->block_size; }
+    static std::size_t chunk_live_count(const void* p) { return chunk_of(p)->live_count; }
+
+    std::size_t get_chunk_count() const { return chunk_count_; }
+    std::size_t get_live_count() const { return live_count_; }
+    std::size_t get_block_size() const { return block_size_; }
+};
+
+// ===== COMPARISON: finding the owning chunk without aligned chunks =====
+// Chunks from new[] are at arbitrary addresses, so resolving pointer -> chunk
+// needs a search: linear over the chunk list, or binary over a sorted one.
+class SearchingChunkPool {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Chunk {
+        char* memory;
+        std::size_t live_count;
+        FreeNode* free_head;
+    };
+
+    std::size_t block_size_;
+    std::size_t blocks_per_chunk_;
+    std::vector<Chunk> chunks_;  // Sorted by address
+    bool binary_search_;
+
+public:
+    SearchingChunkPool(std::size_t block_size, bool binary_search)
+        : block_size_((block_size + 15) & ~std::size_t(15)),
+          blocks_per_chunk_(AlignedChunkPool::CHUNK_SIZE / block_size_),
+          binary_search_(binary_search) {}
+
+    ~SearchingChunkPool() {
+        for (auto& c : chunks_) delete[] c.memory;
+    }
+
+    void* allocate() {
+        for (auto& c : chunks_) {
+            if (c.free_head) {
+                FreeNode* node = c.free_head;
+                c.free_head = node->next;
+                ++c.live_count;
+                return node;
+            }
+        }
+        Chunk c{new char[blocks_per_chunk_ * block_size_], 0, nullptr};
+        for (std::size_t i = blocks_per_chunk_; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(c.memory + (i - 1) * block_size_);
+            node->next = c.free_head;
+            c.free_head = node;
+        }
+        auto pos = std::upper_bound(chunks_.begin(), chunks_.end(), c.memory,
+            [](const char* m, const Chunk& other) { return m < other.memory; });
+        pos = chunks_.insert(pos, c);
+        FreeNode* node = pos->free_head;
+        pos->free_head = node->next;
+        ++pos->live_count;
+        return node;
+    }
+
+    void deallocate(void* p) {
+        char* c = static_cast<char*>(p);
+        Chunk* owner = nullptr;
+        if (binary_search_) {
+            auto it = std::upper_bound(chunks_.begin(), chunks_.end(), c,
+                [](const char* m, const Chunk& other) { return m < other.memory; });
+            owner = &*(it - 1);
+        } else {
+            for (auto& chunk : chunks_) {
+                if (c >= chunk.memory && c < chunk.memory + blocks_per_chunk_ * block_size_) {
+                    owner = &chunk;
+                    break;
+                }
+            }
+        }
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = owner->free_head;
+        owner->free_head = node;
+        --owner->live_count;
+    }
+
+    std::size_t get_chunk_count() const { return chunks_.size(); }
+};
+
+template<typename Pool>
+long long time_random_frees(Pool& pool, std::size_t count) {
+    std::vector<void*> blocks;
+    blocks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        blocks.push_back(pool.allocate());
+    }
+    std::shuffle(blocks.begin(), blocks.end(), std::mt19937(1));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (void* p : blocks) {
+        pool.deallocate(p);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Aligned-chunk Pool (pointer -> chunk by masking) ===\n\n";
+
+    AlignedChunkPool small(32);
+    AlignedChunkPool large(256);
+
+    void* a = small.allocate();
+    void* b = large.allocate();
+    std::cout << "small.owns(a)=" << small.owns(a) << " small.owns(b)=" << small.owns(b)
+              << " large.owns(b)=" << large.owns(b) << "\n";
+    std::cout << "block_size_of(a)=" << AlignedChunkPool::block_size_of(a)
+              << " block_size_of(b)=" << AlignedChunkPool::block_size_of(b) << "\n";
+
+    // Foreign pointers never reach a header. The reserved region below has
+    // its 64KB-aligned first page unmapped, so reading a header there would fault
+    int on_stack = 0;
+    std::vector<int> on_heap(16);
+    char* region = static_cast<char*>(::mmap(nullptr, 2 * AlignedChunkPool::CHUNK_SIZE, PROT_READ | PROT_WRITE,
+                                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (region != MAP_FAILED) {
+        char* aligned = reinterpret_cast<char*>(
+            (reinterpret_cast<uintptr_t>(region) + AlignedChunkPool::CHUNK_SIZE - 1) & ~(AlignedChunkPool::CHUNK_SIZE - 1));
+        ::munmap(aligned, 4096);
+        std::cout << "small.owns(stack)=" << small.owns(&on_stack) << " small.owns(heap)="
+                  << small.owns(on_heap.data()) << " small.owns(unmapped base)=" << small.owns(aligned + 8192) << "\n";
+        ::munmap(region, 2 * AlignedChunkPool::CHUNK_SIZE);
+    }
+
+    // Size-free, pool-free deallocation
+    AlignedChunkPool::deallocate_any(a);
+    AlignedChunkPool::deallocate_any(b);
+    std::cout << "After deallocate_any: small live=" << small.get_live_count()
+              << " large live=" << large.get_live_count() << "\n";
+
+    std::cout << "\n--- Per-chunk accounting returns empty chunks ---\n";
+    std::vector<void*> blocks;
+    for (int i = 0; i < 20000; ++i) blocks.push_back(small.allocate());
+    std::cout << "20000 blocks in " << small.get_chunk_count() << " chunks\n";
+    for (void* p : blocks) small.deallocate(p);
+    std::cout << "After freeing all: " << small.get_chunk_count() << " chunk(s) kept\n";
+
+    std::cout << "\n=== Benchmark: freeing blocks in random order ===\n";
+    const std::size_t COUNT = 500000;  // ~1000 chunks of 64KB at 64-byte blocks
+
+    long long linear_us, binary_us, masked_us;
+    std::size_t chunks;
+    {
+        SearchingChunkPool pool(64, false);
+        linear_us = time_random_frees(pool, COUNT);
+    }
+    {
+        SearchingChunkPool pool(64, true);
+        binary_us = time_random_frees(pool, COUNT);
+        chunks = pool.get_chunk_count();
+    }
+    {
+        AlignedChunkPool pool(64);
+        masked_us = time_random_frees(pool, COUNT);
+    }
+
+    std::cout << COUNT << " frees across ~" << chunks << " chunks\n";
+    std::cout << "Linear chunk search: " << linear_us << " microseconds\n";
+    std::cout << "Binary chunk search: " << binary_us << " microseconds\n";
+    std::cout << "Aligned-chunk mask:  " << masked_us << " microseconds\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Aligned chunks turn pointer -> owner into a single AND\n";
+    std::cout << "- The header carries size class and live count, so free needs no size\n";
+    std::cout << "- Per-chunk live counts let empty chunks go back to the system\n";
+
+    return 0;
+}
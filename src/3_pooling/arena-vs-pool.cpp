@@ -2,6 +2,10 @@
 #include <vector>
 #include <memory>
 #include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <algorithm>
 
 // ===== ARENA ALLOCATOR =====
 // Allocates memory sequentially from a large block
@@ -85,15 +89,26 @@ Block* next;
 };
 
 
+// Each chunk keeps one occupancy bit per block so the pool can find its
+// live objects without the caller tracking them on the side
+struct Chunk {
+    std::unique_ptr<char[]> memory;
+    std::vector<uint64_t> occupied;
+
+    Block* blocks() const { return reinterpret_cast<Block*>(memory.get()); }
+};
+
 Block* freeList;
-std::vector<std::unique_ptr<char[]>> chunks;
+std::vector<Chunk> chunks;  // Kept sorted by address for sequential iteration
 size_t objectsPerChunk;
 size_t totalAllocated;
 size_t totalDeallocated;
 
 void allocateChunk() {
-    auto chunk = std::make_unique<char[]>(objectsPerChunk * sizeof(Block));
-    Block* blocks = reinterpret_cast<Block*>(chunk.get());
+    Chunk chunk;
+    chunk.memory = std::make_unique<char[]>(objectsPerChunk * sizeof(Block));
+    chunk.occupied.assign((objectsPerChunk + 63) / 64, 0);
+    Block* blocks = chunk.blocks();
     
     // Link all blocks in this chunk to the free list
     for (size_t i = 0; i < objectsPerChunk - 1; ++i) {
@@ -102,11 +117,31 @@ void allocateChunk() {
     blocks[objectsPerChunk - 1].next = freeList;
     freeList = blocks;
     
-    chunks.push_back(std::move(chunk));
+    auto pos = std::upper_bound(chunks.begin(), chunks.end(), blocks,
+        [](const Block* b, const Chunk& c) { return b < c.blocks(); });
+    chunks.insert(pos, std::move(chunk));
     std::cout << "Pool: Allocated new chunk with " << objectsPerChunk 
               << " blocks of " << sizeof(T) << " bytes each\n";
 }
 
+// Find the chunk holding a block (chunks are sorted, so binary search)
+Chunk& chunkOf(const Block* block) {
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), block,
+        [](const Block* b, const Chunk& c) { return b < c.blocks(); });
+    return *(it - 1);
+}
+
+void setOccupied(Block* block, bool live) {
+    Chunk& chunk = chunkOf(block);
+    size_t index = block - chunk.blocks();
+    uint64_t bit = uint64_t(1) << (index % 64);
+    if (live) {
+        chunk.occupied[index / 64] |= bit;
+    } else {
+        chunk.occupied[index / 64] &= ~bit;
+    }
+}
+
 
 public:
 explicit PoolAllocator(size_t objectsPerChunk = 1000)
@@ -129,6 +164,7 @@ T* allocate() {
     
     Block* block = freeList;
     freeList = freeList->next;
+    setOccupied(block, true);
     totalAllocated++;
     
     std::cout << "Pool: Allocated object #" << totalAllocated << "\n";
@@ -140,6 +176,7 @@ void deallocate(T* ptr) {
     if (!ptr) return;
     
     Block* block = reinterpret_cast<Block*>(ptr);
+    setOccupied(block, false);
     block->next = freeList;
     freeList = block;
     totalDeallocated++;
@@ -148,6 +185,47 @@ void deallocate(T* ptr) {
               << totalDeallocated << ")\n";
 }
 
+// Visit every live object in address order (chunk by chunk, block by block).
+// fn may destroy and deallocate the object it is given.
+template<typename Fn>
+void for_each_live(Fn&& fn) {
+    for (Chunk& chunk : chunks) {
+        Block* blocks = chunk.blocks();
+        for (size_t word = 0; word < chunk.occupied.size(); ++word) {
+            uint64_t bits = chunk.occupied[word];  // Snapshot, so fn can free
+            while (bits) {
+                size_t index = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                fn(*reinterpret_cast<T*>(&blocks[index]));
+            }
+        }
+    }
+}
+
+// Destroy every live object and rebuild the free list in one pass.
+// The new free list is in address order, so the next allocations are sequential.
+void destroy_all() {
+    size_t destroyed = 0;
+    freeList = nullptr;
+    Block** tail = &freeList;
+    for (Chunk& chunk : chunks) {
+        Block* blocks = chunk.blocks();
+        for (size_t i = 0; i < objectsPerChunk; ++i) {
+            if (chunk.occupied[i / 64] & (uint64_t(1) << (i % 64))) {
+                reinterpret_cast<T*>(&blocks[i])->~T();
+                ++destroyed;
+            }
+            *tail = &blocks[i];
+            tail = &blocks[i].next;
+        }
+        std::fill(chunk.occupied.begin(), chunk.occupied.end(), 0);
+    }
+    *tail = nullptr;
+    totalDeallocated += destroyed;
+    
+    std::cout << "Pool: Destroyed " << destroyed << " live objects, free list rebuilt\n";
+}
+
 size_t getChunkCount() const { return chunks.size(); }
 size_t getActiveObjects() const { return totalAllocated - totalDeallocated; }
 
@@ -234,27 +312,26 @@ PoolAllocator<GameObject> objectPool(100);  // 100 objects per chunk
 // Scenario 1: Object lifecycle management
 std::cout << "\n--- Object lifecycle management ---\n";
 
-std::vector<GameObject*> activeObjects;
-
 // Create some objects
 for (int i = 0; i < 250; ++i) {  // More than one chunk
     GameObject* obj = objectPool.allocate();
     if (obj) {
         new(obj) GameObject(i, i*2, i*3, 100);
-        activeObjects.push_back(obj);
     }
 }
 
-std::cout << "Created " << activeObjects.size() << " objects across " 
+std::cout << "Created " << objectPool.getActiveObjects() << " objects across " 
           << objectPool.getChunkCount() << " chunks\n";
 
-// Remove some objects randomly (individual deallocation)
-for (size_t i = 0; i < activeObjects.size(); i += 3) {
-    GameObject* obj = activeObjects[i];
-    obj->~GameObject();  // Call destructor
-    objectPool.deallocate(obj);
-    activeObjects[i] = nullptr;
-}
+// Remove some objects (individual deallocation) - the pool enumerates
+// its own live objects, no side list needed
+size_t visited = 0;
+objectPool.for_each_live([&](GameObject& obj) {
+    if (visited++ % 3 == 0) {
+        obj.~GameObject();  // Call destructor
+        objectPool.deallocate(&obj);
+    }
+});
 
 std::cout << "Active objects remaining: " << objectPool.getActiveObjects() << "\n";
 
@@ -271,13 +348,14 @@ for (int i = 0; i < 50; ++i) {
 std::cout << "After allocating 50 more: " << objectPool.getActiveObjects() 
           << " active objects\n";
 
-// Cleanup remaining objects
-for (auto* obj : activeObjects) {
-    if (obj) {
-        obj->~GameObject();
-        objectPool.deallocate(obj);
-    }
-}
+// Walk the live objects in address order
+int totalHealth = 0;
+objectPool.for_each_live([&](GameObject& obj) { totalHealth += obj.health; });
+std::cout << "Total health of live objects: " << totalHealth << "\n";
+
+// Cleanup remaining objects - destructors and free list in one pass
+objectPool.destroy_all();
+std::cout << "Active objects after destroy_all: " << objectPool.getActiveObjects() << "\n";
 
 
 }
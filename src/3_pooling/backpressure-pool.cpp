@@ -0,0 +1,404 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../common/alloc_result.hpp"
+#endif
+
+// Backpressure for bounded pools
+// FixedPoolAllocator returns nullptr when full and SimplePoolAllocator
+// throws std::bad_alloc. For a bounded transaction pool shared by producer
+// threads there is a third option: block until a slot is freed, with a
+// timeout. Waiting threads sleep in the kernel (futex on Linux) instead of
+// spinning, so a slow consumer gets the CPU it needs to catch up.
+//
+// The policy is a template parameter. allocate() pops the free list the same
+// way under every policy; policies differ only once it is empty. ReturnNull
+// and Throw pools carry no waiter bookkeeping at all; Block adds one
+// "anyone waiting?" load to deallocate().
+
+enum class ExhaustionPolicy {
+    ReturnNull,  // allocate() returns nullptr
+    Throw,       // allocate() throws std::bad_alloc
+    Block,       // allocate() waits up to the pool's timeout, then returns nullptr
+};
+
+// ===== WAIT PRIMITIVE =====
+// Timed wait on a 32-bit word; std::atomic::wait has no timeout
+namespace futex {
+    // Sleep while *word == expected, for at most `timeout`
+    inline void wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) {
+#ifdef __linux__
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1'000'000'000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+#else
+        // Portable fallback: short sleeps until the word changes or time runs out
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (word.load(std::memory_order_acquire) == expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+#endif
+    }
+
+    inline void wake_one(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+}
+
+// ===== BOUNDED POOL =====
+// Thread-safe fixed-capacity pool. The free list is a Treiber stack of slot
+// indices; the head carries a tag so a pop/push/pop race can't ABA. Links
+// live beside the slots, not inside them, so objects never overlap them.
+template<typename T, std::size_t Capacity, ExhaustionPolicy Policy>
+class BoundedPool {
+    static_assert(Capacity > 0 && Capacity < UINT32_MAX, "slot indices are 32-bit");
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    union Slot {
+        alignas(T) char data[sizeof(T)];
+    };
+
+    Slot slots_[Capacity];
+    std::atomic<uint32_t> next_[Capacity];
+    alignas(64) std::atomic<uint64_t> head_;  // (tag << 32) | index
+
+    // Only touched on the Block slow path, on their own cache line
+    alignas(64) std::atomic<uint32_t> waiters_{0};
+    std::atomic<uint32_t> free_epoch_{0};  // Futex word: bumped when a waiter should retry
+    std::atomic<bool> wake_pending_{false};  // A woken waiter hasn't retried yet
+    std::chrono::nanoseconds timeout_;
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> timeouts_{0};
+
+    static uint64_t pack(uint32_t tag, uint32_t index) { return (static_cast<uint64_t>(tag) << 32) | index; }
+    static uint32_t index_of(uint64_t head) { return static_cast<uint32_t>(head); }
+    static uint32_t tag_of(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+    T* try_pop() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        while (index_of(head) != EMPTY) {
+            uint32_t index = index_of(head);
+            uint32_t next = next_[index].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next), std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+                return reinterpret_cast<T*>(&slots_[index]);
+            }
+        }
+        return nullptr;
+    }
+
+    void push(T* p) {
+        uint32_t index = static_cast<uint32_t>(reinterpret_cast<Slot*>(p) - slots_);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(index_of(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack(tag_of(head) + 1, index), std::memory_order_seq_cst,
+                                              std::memory_order_relaxed));
+    }
+
+    // Slow path for Block: register as a waiter, then retry / sleep until
+    // a slot shows up or the deadline passes
+    T* wait_for_slot(std::chrono::nanoseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        waits_.fetch_add(1, std::memory_order_relaxed);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        T* result = nullptr;
+        // A few yields first: if the consumer is about to free a slot, this
+        // avoids a sleep/wake round trip through the kernel
+        for (int spin = 0; spin < 4 && !result; ++spin) {
+            std::this_thread::yield();
+            result = try_pop();
+        }
+        while (!result) {
+            // Snapshot the epoch before retrying: a push that we miss is
+            // guaranteed to see waiters_ > 0 and bump it, so the wait below
+            // returns immediately instead of sleeping through the wakeup
+            uint32_t epoch = free_epoch_.load(std::memory_order_seq_cst);
+            wake_pending_.store(false, std::memory_order_seq_cst);
+            if ((result = try_pop())) break;
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            futex::wait(free_epoch_, epoch, deadline - now);
+        }
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+        // Frees that arrived while our wakeup was pending didn't wake anyone;
+        // pass the baton if slots are left and others are still asleep
+        if (waiters_.load(std::memory_order_seq_cst) != 0 &&
+            index_of(head_.load(std::memory_order_seq_cst)) != EMPTY) {
+            wake_pending_.store(true, std::memory_order_seq_cst);
+            free_epoch_.fetch_add(1, std::memory_order_seq_cst);
+            futex::wake_one(free_epoch_);
+        }
+        return result;
+    }
+
+public:
+    using value_type = T;
+
+    explicit BoundedPool(std::chrono::nanoseconds timeout = std::chrono::milliseconds(100)) : timeout_(timeout) {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            next_[i].store(i + 1 < Capacity ? static_cast<uint32_t>(i + 1) : EMPTY, std::memory_order_relaxed);
+        }
+        head_.store(pack(0, 0), std::memory_order_release);
+    }
+
+    BoundedPool(const BoundedPool&) = delete;
+    BoundedPool& operator=(const BoundedPool&) = delete;
+
+    T* allocate() {
+        if (T* p = try_pop()) return p;  // Fast path, identical for every policy
+        if constexpr (Policy == ExhaustionPolicy::ReturnNull) {
+            return nullptr;
+        } else if constexpr (Policy == ExhaustionPolicy::Throw) {
+            throw_bad_alloc();
+        } else {
+            return wait_for_slot(timeout_);
+        }
+    }
+
+    // Per-call timeout, Block pools only
+    T* allocate_for(std::chrono::nanoseconds timeout) {
+        static_assert(Policy == ExhaustionPolicy::Block, "allocate_for() needs ExhaustionPolicy::Block");
+        if (T* p = try_pop()) return p;
+        return wait_for_slot(timeout);
+    }
+
+    void deallocate(T* p) {
+        push(p);
+        if constexpr (Policy == ExhaustionPolicy::Block) {
+            // One wakeup in flight at a time: while a woken waiter has not
+            // run yet, further frees just add to the slots it will find
+            if (waiters_.load(std::memory_order_seq_cst) != 0 &&
+                !wake_pending_.exchange(true, std::memory_order_seq_cst)) {
+                free_epoch_.fetch_add(1, std::memory_order_seq_cst);
+                futex::wake_one(free_epoch_);
+            }
+        }
+    }
+
+    uint64_t get_waits() const { return waits_.load(std::memory_order_relaxed); }
+    uint64_t get_timeouts() const { return timeouts_.load(std::memory_order_relaxed); }
+};
+
+// ===== BENCHMARK =====
+struct Transaction {
+    uint64_t id;
+    uint64_t account;
+    double amount;
+    char currency[8];
+};
+
+// Producers -> consumer hand-off; the pool, not this queue, bounds the backlog
+class TransactionQueue {
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Transaction*> items_;
+    bool closed_ = false;
+
+public:
+    void push(Transaction* t) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(t);
+        }
+        ready_.notify_one();
+    }
+
+    Transaction* pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return !items_.empty() || closed_; });
+        if (items_.empty()) return nullptr;
+        Transaction* t = items_.front();
+        items_.pop_front();
+        return t;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        ready_.notify_all();
+    }
+};
+
+// Simulated per-transaction work on the consumer side
+void process(const Transaction& t) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+    volatile double checksum = t.amount;
+    while (std::chrono::steady_clock::now() < until) checksum = checksum * 1.0000001;
+}
+
+const std::size_t POOL_SLOTS = 256;
+const int PRODUCERS = 4;
+const std::size_t PER_PRODUCER = 25'000;
+
+enum class Retry { Drop, Spin };
+
+// CPU time of the calling thread, to see what producers burn while the pool is empty
+double thread_cpu_ms() {
+#ifdef __linux__
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+#else
+    return 0.0;
+#endif
+}
+
+struct RunResult {
+    double wall_ms;
+    double producer_cpu_ms;
+    uint64_t delivered;
+    uint64_t dropped;
+    uint64_t failed_attempts;
+};
+
+template<ExhaustionPolicy Policy>
+RunResult run_flood(Retry retry) {
+    BoundedPool<Transaction, POOL_SLOTS, Policy> pool(std::chrono::milliseconds(50));
+    TransactionQueue queue;
+    std::atomic<uint64_t> delivered{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> failed{0};
+    std::mutex cpu_mutex;
+    double producer_cpu_ms = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread consumer([&] {
+        while (Transaction* t = queue.pop()) {
+            process(*t);
+            pool.deallocate(t);
+            delivered.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::size_t i = 0; i < PER_PRODUCER; ++i) {
+                Transaction* t = nullptr;
+                while (!t) {
+#if defined(__cpp_exceptions)
+                    if constexpr (Policy == ExhaustionPolicy::Throw) {
+                        try {
+                            t = pool.allocate();
+                        } catch (const std::bad_alloc&) {
+                        }
+                    } else {
+                        t = pool.allocate();
+                    }
+#else
+                    t = pool.allocate();
+#endif
+                    if (t) break;
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                    if (retry == Retry::Drop) break;
+                    std::this_thread::yield();
+                }
+                if (!t) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                *t = Transaction{static_cast<uint64_t>(p) * PER_PRODUCER + i, i % 1000, 1.0 * i, "USD"};
+                queue.push(t);
+            }
+            std::lock_guard<std::mutex> lock(cpu_mutex);
+            producer_cpu_ms += thread_cpu_ms();
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    queue.close();
+    consumer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return {std::chrono::duration<double, std::milli>(end - start).count(), producer_cpu_ms, delivered.load(),
+            dropped.load(), failed.load()};
+}
+
+void print_result(const char* label, const RunResult& r) {
+    std::cout << label << "\n";
+    std::cout << "  wall " << r.wall_ms << " ms, producer CPU " << r.producer_cpu_ms << " ms, delivered " << r.delivered
+              << ", dropped " << r.dropped << ", failed allocate() calls " << r.failed_attempts << "\n";
+}
+
+int main() {
+    std::cout << "=== Backpressure Exhaustion Policy for Bounded Pools ===\n\n";
+
+    std::cout << "--- Blocking allocate with timeout ---\n";
+    {
+        BoundedPool<Transaction, 2, ExhaustionPolicy::Block> pool(std::chrono::milliseconds(20));
+        Transaction* a = pool.allocate();
+        Transaction* b = pool.allocate();
+        auto start = std::chrono::steady_clock::now();
+        Transaction* c = pool.allocate();
+        auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Pool of 2 full; third allocate() gave up after " << waited.count() << " ms -> "
+                  << (c ? "slot" : "nullptr") << "\n";
+
+        std::thread releaser([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            pool.deallocate(a);
+        });
+        start = std::chrono::steady_clock::now();
+        c = pool.allocate_for(std::chrono::seconds(1));
+        waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        releaser.join();
+        std::cout << "Another thread frees a slot after 5 ms; waiter woke after " << waited.count() << " ms -> "
+                  << (c ? "slot" : "nullptr") << "\n";
+        pool.deallocate(b);
+        pool.deallocate(c);
+        std::cout << "Waits: " << pool.get_waits() << ", timeouts: " << pool.get_timeouts() << "\n";
+    }
+
+    std::cout << "\n=== Benchmark: " << PRODUCERS << " producers x " << PER_PRODUCER
+              << " transactions, " << POOL_SLOTS << "-slot pool, consumer at ~2 us each ===\n";
+
+    print_result("ReturnNull, drop when full:", run_flood<ExhaustionPolicy::ReturnNull>(Retry::Drop));
+    print_result("ReturnNull, yield and retry:", run_flood<ExhaustionPolicy::ReturnNull>(Retry::Spin));
+#if defined(__cpp_exceptions)
+    print_result("Throw, catch and retry:", run_flood<ExhaustionPolicy::Throw>(Retry::Spin));
+#else
+    std::cout << "Throw, catch and retry: skipped (built with -fno-exceptions)\n";
+#endif
+    print_result("Block (futex wait, 50 ms timeout):", run_flood<ExhaustionPolicy::Block>(Retry::Spin));
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Dropping keeps producers fast but loses work\n";
+    std::cout << "- Retrying in a loop burns CPU the slow consumer needs\n";
+    std::cout << "- Blocking turns exhaustion into backpressure: producers sleep until a slot frees\n";
+    std::cout << "- The non-blocking fast path is unchanged; waiting is paid only when the pool is empty\n";
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// PoolAllocated<Derived> - class-scoped operator new/delete backed by a pool
+// Inherit from it and every plain `new Derived` / `delete ptr` goes through a
+// per-class pool sized for sizeof(Derived), with a per-thread cache in front
+// of it. No call sites change.
+//
+// Hierarchies: a subclass that is bigger than the pooled class still inherits
+// these operators. operator new sees the real size and sends it to the global
+// heap, and - as long as the base has a virtual destructor - sized operator
+// delete receives the dynamic type's size, so the free goes back to the right
+// place.
+template<typename Derived>
+class PoolAllocated {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 1024;
+    static constexpr std::size_t BATCH = 64;            // Blocks moved between cache and central pool
+    static constexpr std::size_t MAX_CACHED = 2 * BATCH;
+
+    static constexpr std::size_t block_size() {
+        constexpr std::size_t align = alignof(Derived) > alignof(FreeNode) ? alignof(Derived) : alignof(FreeNode);
+        constexpr std::size_t size = sizeof(Derived) > sizeof(FreeNode) ? sizeof(Derived) : sizeof(FreeNode);
+        return (size + align - 1) & ~(align - 1);
+    }
+
+    // Central pool shared by all threads
+    struct CentralPool {
+        std::mutex mutex_;
+        FreeNode* free_head_ = nullptr;
+        std::vector<std::unique_ptr<char[]>> chunks_;
+
+        void allocate_chunk() {
+            // operator new[] for char gives max_align_t alignment
+            static_assert(alignof(Derived) <= alignof(std::max_align_t),
+                          "over-aligned classes are not supported");
+            auto chunk = std::make_unique<char[]>(BLOCKS_PER_CHUNK * block_size());
+            for (std::size_t i = 0; i < BLOCKS_PER_CHUNK; ++i) {
+                FreeNode* node = reinterpret_cast<FreeNode*>(chunk.get() + i * block_size());
+                node->next = free_head_;
+                free_head_ = node;
+            }
+            chunks_.push_back(std::move(chunk));
+        }
+
+        // Hand out up to 'count' blocks as a linked list
+        FreeNode* take(std::size_t count, std::size_t& taken) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_head_) {
+                allocate_chunk();
+            }
+            FreeNode* first = free_head_;
+            FreeNode* last = first;
+            taken = 1;
+            while (taken < count && last->next) {
+                last = last->next;
+                ++taken;
+            }
+            free_head_ = last->next;
+            last->next = nullptr;
+            return first;
+        }
+
+        void give(FreeNode* first, FreeNode* last) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last->next = free_head_;
+            free_head_ = first;
+        }
+    };
+
+    // Per-thread cache - the fast path touches only this
+    struct ThreadCache {
+        FreeNode* free_head_ = nullptr;
+        std::size_t count_ = 0;
+
+        ~ThreadCache() {
+            // Thread exit: return everything so other threads can reuse it
+            if (free_head_) {
+                FreeNode* last = free_head_;
+                while (last->next) last = last->next;
+                central().give(free_head_, last);
+            }
+        }
+
+        void flush_batch() {
+            FreeNode* first = free_head_;
+            FreeNode* last = first;
+            for (std::size_t i = 1; i < BATCH; ++i) {
+                last = last->next;
+            }
+            free_head_ = last->next;
+            count_ -= BATCH;
+            central().give(first, last);
+        }
+    };
+
+    static CentralPool& central() {
+        // Never destroyed: thread caches may flush into it during shutdown
+        static CentralPool* pool = new CentralPool();
+        return *pool;
+    }
+
+    static ThreadCache& cache() {
+        thread_local ThreadCache instance;
+        return instance;
+    }
+
+public:
+    static void* operator new(std::size_t size) {
+        if (size > block_size()) {
+            return ::operator new(size);  // A larger subclass
+        }
+        ThreadCache& tc = cache();
+        if (!tc.free_head_) {
+            tc.free_head_ = central().take(BATCH, tc.count_);
+        }
+        FreeNode* node = tc.free_head_;
+        tc.free_head_ = node->next;
+        --tc.count_;
+        return node;
+    }
+
+    static void operator delete(void* p, std::size_t size) noexcept {
+        if (p == nullptr) return;
+        if (size > block_size()) {
+            ::operator delete(p, size);
+            return;
+        }
+        ThreadCache& tc = cache();
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = tc.free_head_;
+        tc.free_head_ = node;
+        if (++tc.count_ > MAX_CACHED) {
+            tc.flush_batch();
+        }
+    }
+
+    // Arrays keep using the global heap - the pool is for single objects
+    static void* operator new[](std::size_t size) { return ::operator new[](size); }
+    static void operator delete[](void* p) noexcept { ::operator delete[](p); }
+
+    static std::size_t get_chunk_count() {
+        std::lock_guard<std::mutex> lock(central().mutex_);
+        return central().chunks_.size();
+    }
+};
+
+// ===== EXAMPLE HIERARCHY =====
+struct Shape : PoolAllocated<Shape> {
+    float x = 0, y = 0;
+    virtual ~Shape() = default;   // Needed for sized delete to see the real size
+    virtual float area() const = 0;
+};
+
+// Bigger than Shape and doesn't opt in, so Shape's size check sends it to
+// the global heap
+struct Circle : Shape {
+    float radius;
+    explicit Circle(float r) : radius(r) {}
+    float area() const override { return 3.14159f * radius * radius; }
+};
+
+// A subclass can take its own pool by mixing in again and choosing which
+// operators win
+struct Rectangle : Shape, PoolAllocated<Rectangle> {
+    using PoolAllocated<Rectangle>::operator new;
+    using PoolAllocated<Rectangle>::operator delete;
+    using PoolAllocated<Rectangle>::operator new[];
+    using PoolAllocated<Rectangle>::operator delete[];
+
+    float w, h;
+    Rectangle(float width, float height) : w(width), h(height) {}
+    float area() const override { return w * h; }
+};
+
+// Same shapes without the mixin, for the benchmark
+struct PlainShape {
+    float x = 0, y = 0;
+    virtual ~PlainShape() = default;
+    virtual float area() const = 0;
+};
+
+struct PlainRectangle : PlainShape {
+    float w, h;
+    PlainRectangle(float width, float height) : w(width), h(height) {}
+    float area() const override { return w * h; }
+};
+
+template<typename Base, typename Concrete>
+long long churn(std::size_t live, std::size_t rounds) {
+    std::vector<Base*> objects(live, nullptr);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (auto& obj : objects) {
+            obj = new Concrete(1.0f, 2.0f);
+        }
+        for (auto& obj : objects) {
+            delete obj;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+template<typename Base, typename Concrete>
+long long churn_threads(unsigned threads, std::size_t live, std::size_t rounds) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([=] { churn<Base, Concrete>(live, rounds); });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Class-scoped Pool Allocation (PoolAllocated<Derived>) ===\n\n";
+
+    std::cout << "--- Plain new/delete through a base pointer ---\n";
+    Shape* rect = new Rectangle(3, 4);
+    Shape* circle = new Circle(1);
+    std::cout << "Rectangle area " << rect->area() << ", circle area " << circle->area() << "\n";
+    std::cout << "Rectangle pool chunks: " << PoolAllocated<Rectangle>::get_chunk_count() << "\n";
+    std::cout << "Shape pool chunks:     " << PoolAllocated<Shape>::get_chunk_count()
+              << " (Circle is bigger than Shape, so it used the global heap)\n";
+    delete rect;    // Sized delete routes back to the Rectangle pool
+    delete circle;  // ...and this one back to the global heap
+
+    std::cout << "\n=== Benchmark: polymorphic new/delete ===\n";
+    const std::size_t LIVE = 10000;
+    const std::size_t ROUNDS = 200;
+
+    long long global_us = churn<PlainShape, PlainRectangle>(LIVE, ROUNDS);
+    long long pooled_us = churn<Shape, Rectangle>(LIVE, ROUNDS);
+    std::cout << "Single thread, " << LIVE << " objects x " << ROUNDS << " rounds\n";
+    std::cout << "Global new:     " << global_us << " microseconds\n";
+    std::cout << "PoolAllocated:  " << pooled_us << " microseconds\n";
+
+    const unsigned THREADS = 4;
+    global_us = churn_threads<PlainShape, PlainRectangle>(THREADS, LIVE, ROUNDS);
+    pooled_us = churn_threads<Shape, Rectangle>(THREADS, LIVE, ROUNDS);
+    std::cout << THREADS << " threads\n";
+    std::cout << "Global new:     " << global_us << " microseconds\n";
+    std::cout << "PoolAllocated:  " << pooled_us << " microseconds\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- One base class gives a type pool allocation with no call-site changes\n";
+    std::cout << "- Thread caches keep the fast path lock-free\n";
+    std::cout << "- A virtual destructor makes sized delete correct across the hierarchy\n";
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Compacting pool
+// Callers hold Handles, never raw pointers, so the pool is free to move
+// objects. compact() moves live objects out of the sparsest chunks into the
+// densest ones, patches the handle table, and releases chunks that end up
+// empty - the fragmentation a plain free-list pool can never undo.
+struct Handle {
+    uint32_t index = 0xFFFFFFFF;
+    uint32_t generation = 0;
+};
+
+struct CompactionStats {
+    std::size_t objects_moved = 0;
+    std::size_t chunks_released = 0;
+    std::size_t bytes_reclaimed = 0;
+    long long pause_us = 0;
+};
+
+template<typename T, std::size_t SlotsPerChunk = 1024>
+class CompactingPool {
+private:
+    static_assert(SlotsPerChunk % 64 == 0, "occupancy is tracked in 64-bit words");
+    static constexpr std::size_t WORDS = SlotsPerChunk / 64;
+
+    struct Slot {
+        alignas(T) unsigned char data[sizeof(T)];
+        T* object() { return std::launder(reinterpret_cast<T*>(data)); }
+    };
+
+    struct Chunk {
+        Slot slots[SlotsPerChunk];
+        uint64_t occupied[WORDS] = {};
+        uint32_t handle_of[SlotsPerChunk];  // Back-reference for moving
+        std::size_t live = 0;
+    };
+
+    struct HandleEntry {
+        Chunk* chunk;
+        uint32_t slot;
+        uint32_t generation;
+        uint32_t next_free;  // Free-list link while unused
+    };
+
+    static constexpr uint32_t NO_ENTRY = 0xFFFFFFFF;
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<HandleEntry> handles_;
+    uint32_t free_handle_ = NO_ENTRY;
+    Chunk* fill_hint_ = nullptr;  // Chunk currently being filled
+    std::size_t live_ = 0;
+
+    // Memcpy is a valid move for these; others are move-constructed
+    static constexpr bool trivially_relocatable = std::is_trivially_copyable_v<T>;
+
+    static int first_free_slot(const Chunk& chunk) {
+        for (std::size_t w = 0; w < WORDS; ++w) {
+            uint64_t free_bits = ~chunk.occupied[w];
+            if (free_bits) return static_cast<int>(w * 64 + __builtin_ctzll(free_bits));
+        }
+        return -1;
+    }
+
+    static void mark(Chunk& chunk, std::size_t slot, bool live) {
+        uint64_t bit = uint64_t(1) << (slot % 64);
+        if (live) chunk.occupied[slot / 64] |= bit;
+        else chunk.occupied[slot / 64] &= ~bit;
+    }
+
+    Chunk* chunk_with_space() {
+        if (fill_hint_ && fill_hint_->live < SlotsPerChunk) return fill_hint_;
+        // Densest chunk that still has room keeps objects packed
+        Chunk* best = nullptr;
+        for (auto& c : chunks_) {
+            if (c->live < SlotsPerChunk && (!best || c->live > best->live)) best = c.get();
+        }
+        if (!best) {
+            chunks_.push_back(std::make_unique<Chunk>());
+            best = chunks_.back().get();
+        }
+        fill_hint_ = best;
+        return best;
+    }
+
+    uint32_t new_handle_entry() {
+        if (free_handle_ != NO_ENTRY) {
+            uint32_t index = free_handle_;
+            free_handle_ = handles_[index].next_free;
+            return index;
+        }
+        handles_.push_back({nullptr, 0, 0, NO_ENTRY});
+        return static_cast<uint32_t>(handles_.size() - 1);
+    }
+
+    void relocate(Chunk& from, std::size_t from_slot, Chunk& to, std::size_t to_slot) {
+        T* src = from.slots[from_slot].object();
+        if constexpr (trivially_relocatable) {
+            std::memcpy(to.slots[to_slot].data, from.slots[from_slot].data, sizeof(T));
+        } else {
+            ::new (to.slots[to_slot].data) T(std::move(*src));
+            src->~T();
+        }
+        uint32_t handle_index = from.handle_of[from_slot];
+        to.handle_of[to_slot] = handle_index;
+        handles_[handle_index].chunk = &to;
+        handles_[handle_index].slot = static_cast<uint32_t>(to_slot);
+
+        mark(from, from_slot, false);
+        mark(to, to_slot, true);
+        --from.live;
+        ++to.live;
+    }
+
+public:
+    CompactingPool() = default;
+
+    ~CompactingPool() {
+        for (auto& c : chunks_) {
+            for (std::size_t s = 0; s < SlotsPerChunk; ++s) {
+                if (c->occupied[s / 64] & (uint64_t(1) << (s % 64))) c->slots[s].object()->~T();
+            }
+        }
+    }
+
+    CompactingPool(const CompactingPool&) = delete;
+    CompactingPool& operator=(const CompactingPool&) = delete;
+
+    template<typename... Args>
+    Handle create(Args&&... args) {
+        Chunk* chunk = chunk_with_space();
+        int slot = first_free_slot(*chunk);
+        ::new (chunk->slots[slot].data) T(std::forward<Args>(args)...);
+
+        uint32_t index = new_handle_entry();
+        handles_[index].chunk = chunk;
+        handles_[index].slot = static_cast<uint32_t>(slot);
+        chunk->handle_of[slot] = index;
+        mark(*chunk, slot, true);
+        ++chunk->live;
+        ++live_;
+        return {index, handles_[index].generation};
+    }
+
+    // nullptr for a stale or invalid handle
+    T* get(Handle h) {
+        if (h.index >= handles_.size() || handles_[h.index].generation != h.generation ||
+            handles_[h.index].chunk == nullptr) {
+            return nullptr;
+        }
+        return handles_[h.index].chunk->slots[handles_[h.index].slot].object();
+    }
+
+    void destroy(Handle h) {
+        if (!get(h)) return;
+        HandleEntry& entry = handles_[h.index];
+        Chunk& chunk = *entry.chunk;
+        chunk.slots[entry.slot].object()->~T();
+        mark(chunk, entry.slot, false);
+        --chunk.live;
+        --live_;
+
+        entry.chunk = nullptr;
+        ++entry.generation;  // Outstanding copies of h go stale
+        entry.next_free = free_handle_;
+        free_handle_ = h.index;
+    }
+
+    // Move live objects from the sparsest chunks into the densest ones and
+    // release every chunk that becomes empty
+    CompactionStats compact() {
+        CompactionStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::sort(chunks_.begin(), chunks_.end(),
+                  [](const auto& a, const auto& b) { return a->live > b->live; });
+
+        std::size_t dst = 0;
+        std::size_t src = chunks_.size();
+        while (src > 0) {
+            --src;
+            Chunk& from = *chunks_[src];
+            // Skip full destinations
+            while (dst < src && chunks_[dst]->live == SlotsPerChunk) ++dst;
+            if (dst >= src) break;
+
+            for (std::size_t w = 0; w < WORDS && from.live > 0; ++w) {
+                uint64_t bits = from.occupied[w];
+                while (bits) {
+                    std::size_t slot = w * 64 + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    while (dst < src && chunks_[dst]->live == SlotsPerChunk) ++dst;
+                    if (dst >= src) break;
+                    relocate(from, slot, *chunks_[dst], first_free_slot(*chunks_[dst]));
+                    ++stats.objects_moved;
+                }
+                if (dst >= src) break;
+            }
+        }
+
+        // Every chunk past the packed prefix that is now empty can go
+        std::size_t before = chunks_.size();
+        chunks_.erase(std::remove_if(chunks_.begin(), chunks_.end(),
+                                     [](const auto& c) { return c->live == 0; }),
+                      chunks_.end());
+        fill_hint_ = nullptr;
+        stats.chunks_released = before - chunks_.size();
+        stats.bytes_reclaimed = stats.chunks_released * sizeof(Chunk);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        stats.pause_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        return stats;
+    }
+
+    std::size_t get_chunk_count() const { return chunks_.size(); }
+    std::size_t get_live_count() const { return live_; }
+    std::size_t get_bytes_reserved() const { return chunks_.size() * sizeof(Chunk); }
+};
+
+// ===== TEST TYPES =====
+struct Position {  // Trivially relocatable - moved with memcpy
+    double x, y, z;
+    uint64_t id;
+};
+
+struct Transaction {  // Needs real move construction
+    uint64_t id;
+    std::string merchant;
+    double amount;
+    Transaction(uint64_t i, std::string m, double a) : id(i), merchant(std::move(m)), amount(a) {}
+};
+
+template<typename T, typename Make, typename Check>
+void fragment_and_compact(const char* label, Make&& make, Check&& check) {
+    const std::size_t COUNT = 500000;
+    CompactingPool<T> pool;
+    std::vector<Handle> handles;
+    handles.reserve(COUNT);
+    for (std::size_t i = 0; i < COUNT; ++i) handles.push_back(pool.create(make(i)));
+
+    // Destroy 85% at random, leaving survivors spread across every chunk
+    std::mt19937 rng(5);
+    std::vector<Handle> survivors;
+    std::vector<uint64_t> survivor_ids;
+    Handle destroyed;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        if (rng() % 100 < 85) {
+            pool.destroy(handles[i]);
+            destroyed = handles[i];
+        } else {
+            survivors.push_back(handles[i]);
+            survivor_ids.push_back(i);
+        }
+    }
+
+    std::size_t chunks_before = pool.get_chunk_count();
+    std::size_t bytes_before = pool.get_bytes_reserved();
+    CompactionStats stats = pool.compact();
+
+    bool ok = true;
+    for (std::size_t i = 0; i < survivors.size(); ++i) {
+        const T* obj = pool.get(survivors[i]);
+        ok = ok && obj && check(*obj, survivor_ids[i]);
+    }
+    bool stale_rejected = pool.get(destroyed) == nullptr;
+
+    std::cout << label << ": " << pool.get_live_count() << " live objects\n";
+    std::cout << "  chunks " << chunks_before << " -> " << pool.get_chunk_count()
+              << ", moved " << stats.objects_moved << " objects\n";
+    std::cout << "  reclaimed " << (stats.bytes_reclaimed >> 20) << " MB of "
+              << (bytes_before >> 20) << " MB, pause " << stats.pause_us << " microseconds\n";
+    std::cout << "  handles still valid: " << (ok ? "yes" : "NO")
+              << ", stale handles rejected: " << (stale_rejected ? "yes" : "NO") << "\n";
+}
+
+int main() {
+    std::cout << "=== Compacting Pool with Handles ===\n\n";
+
+    fragment_and_compact<Position>(
+        "Position (memcpy relocation)",
+        [](std::size_t i) { return Position{double(i), double(i) * 2, 0, i}; },
+        [](const Position& p, uint64_t id) { return p.id == id && p.x == double(id); });
+
+    fragment_and_compact<Transaction>(
+        "Transaction (move construction)",
+        [](std::size_t i) { return Transaction(i, "MERCHANT-NUMBER-" + std::to_string(i), i * 0.01); },
+        [](const Transaction& t, uint64_t id) {
+            return t.id == id && t.merchant == "MERCHANT-NUMBER-" + std::to_string(id);
+        });
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Handles add one indirection but make objects movable\n";
+    std::cout << "- Compaction packs survivors and returns whole chunks\n";
+    std::cout << "- Trivially copyable types relocate with memcpy\n";
+
+    return 0;
+}
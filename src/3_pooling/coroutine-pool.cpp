@@ -0,0 +1,282 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <vector>
+
+// Coroutine-awaitable pool acquisition
+// In a coroutine-based I/O layer a thread must never block on an empty pool
+// (see backpressure-pool.cpp for the thread-blocking version). Instead,
+// `co_await pool.acquire()` suspends just the coroutine. When a slot is
+// released, it goes straight to the longest-waiting coroutine (FIFO, no
+// barging), which is queued on the executor to resume.
+//
+// Waiters are intrusive: each awaiter lives in its coroutine frame while
+// suspended, so queuing a waiter allocates nothing.
+
+// ===== EXECUTOR =====
+// Single-threaded run queue; enough to drive tests and benchmarks
+class Executor {
+private:
+    std::deque<std::coroutine_handle<>> ready_;
+    uint64_t resumptions_ = 0;
+    uint64_t tick_ = 0;
+
+public:
+    void schedule(std::coroutine_handle<> h) { ready_.push_back(h); }
+
+    void run() {
+        while (!ready_.empty()) {
+            std::coroutine_handle<> h = ready_.front();
+            ready_.pop_front();
+            ++resumptions_;
+            ++tick_;
+            h.resume();
+        }
+    }
+
+    // co_await executor.yield(): go to the back of the run queue
+    auto yield() {
+        struct YieldAwaiter {
+            Executor& executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { executor.schedule(h); }
+            void await_resume() const noexcept {}
+        };
+        return YieldAwaiter{*this};
+    }
+
+    uint64_t get_resumptions() const { return resumptions_; }
+    uint64_t get_tick() const { return tick_; }
+};
+
+// Fire-and-forget coroutine started on an executor; the frame frees itself
+// when the body finishes
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+void spawn(Executor& executor, Task task) {
+    executor.schedule(task.handle);
+}
+
+// ===== ASYNC POOL =====
+template<typename T, std::size_t Capacity>
+class AsyncPool {
+private:
+    union Slot {
+        alignas(T) char data[sizeof(T)];
+        Slot* next;
+    };
+
+public:
+    // Awaiter returned by acquire(); doubles as the wait-queue node
+    class AcquireAwaiter {
+    private:
+        AsyncPool& pool_;
+        std::coroutine_handle<> handle_;
+        AcquireAwaiter* next_ = nullptr;
+        T* slot_ = nullptr;
+        friend class AsyncPool;
+
+    public:
+        explicit AcquireAwaiter(AsyncPool& pool) : pool_(pool) {}
+
+        bool await_ready() {
+            slot_ = pool_.try_acquire();
+            return slot_ != nullptr;
+        }
+
+        void await_suspend(std::coroutine_handle<> h) {
+            handle_ = h;
+            pool_.enqueue(this);
+        }
+
+        T* await_resume() const noexcept { return slot_; }
+    };
+
+private:
+    Slot slots_[Capacity];
+    Slot* free_head_ = nullptr;
+    AcquireAwaiter* wait_head_ = nullptr;
+    AcquireAwaiter* wait_tail_ = nullptr;
+    Executor& executor_;
+    std::size_t waiting_ = 0;
+    std::size_t max_waiting_ = 0;
+
+    void enqueue(AcquireAwaiter* waiter) {
+        if (wait_tail_) wait_tail_->next_ = waiter;
+        else wait_head_ = waiter;
+        wait_tail_ = waiter;
+        max_waiting_ = std::max(max_waiting_, ++waiting_);
+    }
+
+public:
+    explicit AsyncPool(Executor& executor) : executor_(executor) {
+        for (std::size_t i = Capacity; i > 0; --i) {
+            slots_[i - 1].next = free_head_;
+            free_head_ = &slots_[i - 1];
+        }
+    }
+
+    AsyncPool(const AsyncPool&) = delete;
+    AsyncPool& operator=(const AsyncPool&) = delete;
+
+    // co_await pool.acquire() -> T*; suspends while the pool is empty
+    AcquireAwaiter acquire() { return AcquireAwaiter(*this); }
+
+    // Non-suspending attempt; nullptr when empty or when others are queued
+    T* try_acquire() {
+        if (!free_head_ || wait_head_) return nullptr;  // Queued waiters go first
+        Slot* slot = free_head_;
+        free_head_ = slot->next;
+        return reinterpret_cast<T*>(slot);
+    }
+
+    // Hand the slot to the oldest waiter, or back to the free list
+    void release(T* p) {
+        if (AcquireAwaiter* waiter = wait_head_) {
+            wait_head_ = waiter->next_;
+            if (!wait_head_) wait_tail_ = nullptr;
+            --waiting_;
+            waiter->slot_ = p;
+            executor_.schedule(waiter->handle_);
+            return;
+        }
+        Slot* slot = reinterpret_cast<Slot*>(p);
+        slot->next = free_head_;
+        free_head_ = slot;
+    }
+
+    std::size_t get_waiting() const { return waiting_; }
+    std::size_t get_max_waiting() const { return max_waiting_; }
+};
+
+// ===== DEMO =====
+struct Connection {
+    int id;
+    uint64_t bytes_sent;
+};
+
+Task client(Executor& executor, AsyncPool<Connection, 2>& pool, int id, std::vector<int>& order) {
+    std::cout << "client " << id << " wants a connection\n";
+    Connection* c = co_await pool.acquire();
+    order.push_back(id);
+    std::cout << "client " << id << " got a connection (" << pool.get_waiting() << " waiting)\n";
+    c->id = id;
+    c->bytes_sent = 0;
+    for (int i = 0; i < 2; ++i) {
+        c->bytes_sent += 512;
+        co_await executor.yield();  // Simulated I/O
+    }
+    std::cout << "client " << id << " done, releasing\n";
+    pool.release(c);
+}
+
+// ===== BENCHMARK =====
+const std::size_t SLOTS = 16;
+const int COROUTINES = 10'000;
+const int ROUNDS = 10;
+const int IO_STEPS = 3;
+
+struct WaitStats {
+    uint64_t total_wait = 0;  // Executor ticks between asking and getting a slot
+    uint64_t max_wait = 0;
+    uint64_t completed = 0;
+
+    void record(uint64_t asked, uint64_t got) {
+        uint64_t wait = got - asked;
+        total_wait += wait;
+        max_wait = std::max(max_wait, wait);
+    }
+};
+
+struct Message {
+    uint64_t payload[8];
+};
+
+Task awaiting_worker(Executor& executor, AsyncPool<Message, SLOTS>& pool, WaitStats& stats) {
+    for (int r = 0; r < ROUNDS; ++r) {
+        uint64_t asked = executor.get_tick();
+        Message* m = co_await pool.acquire();
+        stats.record(asked, executor.get_tick());
+        m->payload[0] = static_cast<uint64_t>(r);
+        for (int i = 0; i < IO_STEPS; ++i) co_await executor.yield();
+        pool.release(m);
+    }
+    ++stats.completed;
+}
+
+// Baseline without suspension: poll try_acquire() and yield on failure
+Task polling_worker(Executor& executor, AsyncPool<Message, SLOTS>& pool, WaitStats& stats) {
+    for (int r = 0; r < ROUNDS; ++r) {
+        uint64_t asked = executor.get_tick();
+        Message* m;
+        while (!(m = pool.try_acquire())) co_await executor.yield();
+        stats.record(asked, executor.get_tick());
+        m->payload[0] = static_cast<uint64_t>(r);
+        for (int i = 0; i < IO_STEPS; ++i) co_await executor.yield();
+        pool.release(m);
+    }
+    ++stats.completed;
+}
+
+template<typename Worker>
+void run_benchmark(const char* label, Worker worker) {
+    Executor executor;
+    AsyncPool<Message, SLOTS> pool(executor);
+    WaitStats stats;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < COROUTINES; ++i) spawn(executor, worker(executor, pool, stats));
+    executor.run();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    uint64_t acquisitions = static_cast<uint64_t>(COROUTINES) * ROUNDS;
+    std::cout << label << "\n";
+    std::cout << "  " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+              << executor.get_resumptions() << " resumptions, " << stats.completed << "/" << COROUTINES
+              << " finished\n";
+    std::cout << "  wait per acquire: avg " << stats.total_wait / acquisitions << " ticks, max " << stats.max_wait
+              << " ticks; longest queue " << pool.get_max_waiting() << "\n";
+}
+
+int main() {
+    std::cout << "=== Coroutine-awaitable Pool Acquisition ===\n\n";
+
+    std::cout << "--- 5 clients, pool of 2 connections ---\n";
+    {
+        Executor executor;
+        AsyncPool<Connection, 2> pool(executor);
+        std::vector<int> order;
+        for (int id = 1; id <= 5; ++id) spawn(executor, client(executor, pool, id, order));
+        executor.run();
+        std::cout << "Acquisition order:";
+        for (int id : order) std::cout << " " << id;
+        std::cout << (std::is_sorted(order.begin(), order.end()) ? " (FIFO)\n" : " (not FIFO!)\n");
+    }
+
+    std::cout << "\n=== Benchmark: " << COROUTINES << " coroutines x " << ROUNDS << " acquisitions, " << SLOTS
+              << "-slot pool ===\n";
+    run_benchmark("co_await acquire() (suspend, FIFO hand-off):", awaiting_worker);
+    run_benchmark("try_acquire() + yield polling:", polling_worker);
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Suspended coroutines cost nothing until a slot is handed to them\n";
+    std::cout << "- Direct hand-off to the oldest waiter gives FIFO order and bounded waits\n";
+    std::cout << "- Polling burns resumptions and lets late arrivals barge ahead\n";
+
+    return 0;
+}
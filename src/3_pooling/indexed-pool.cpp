@@ -0,0 +1,388 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Pool with an integrated id index
+// Transactions are looked up by external id while they sit in the pool.
+// The usual answer is a std::unordered_map<id, T*> next to the pool: one
+// heap node per entry, a pointer chase per lookup, and a second allocator
+// in the hot path. Here the pool owns a flat open-addressing table that maps
+// id -> slot index, updated by create() and release():
+// - linear probing over 16-byte entries, at most 50% full
+// - backward-shift deletion, so there are no tombstones to clean up
+// - one array, grown by doubling; no per-entry allocation
+
+// ===== ID INDEX =====
+class IdIndex {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+private:
+    struct Entry {
+        uint64_t id;
+        uint32_t slot;  // NOT_FOUND marks an empty entry, so every id value is usable
+        uint32_t reserved;
+    };
+
+    std::unique_ptr<Entry[]> entries_;
+    std::size_t mask_ = 0;
+    std::size_t size_ = 0;
+
+    // Finalizer from MurmurHash3: spreads sequential and clustered ids
+    static uint64_t hash(uint64_t id) {
+        id ^= id >> 33;
+        id *= 0xff51afd7ed558ccdULL;
+        id ^= id >> 33;
+        id *= 0xc4ceb9fe1a85ec53ULL;
+        id ^= id >> 33;
+        return id;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::unique_ptr<Entry[]> old = std::move(entries_);
+        std::size_t old_capacity = old ? mask_ + 1 : 0;
+        entries_ = std::make_unique<Entry[]>(capacity);
+        for (std::size_t i = 0; i < capacity; ++i) entries_[i].slot = NOT_FOUND;
+        mask_ = capacity - 1;
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old[i].slot == NOT_FOUND) continue;
+            std::size_t pos = hash(old[i].id) & mask_;
+            while (entries_[pos].slot != NOT_FOUND) pos = (pos + 1) & mask_;
+            entries_[pos] = old[i];
+        }
+    }
+
+public:
+    explicit IdIndex(std::size_t expected = 1024) {
+        std::size_t capacity = 16;
+        while (capacity < expected * 2) capacity *= 2;
+        rehash(capacity);
+    }
+
+    uint32_t find(uint64_t id) const {
+        std::size_t pos = hash(id) & mask_;
+        while (true) {
+            const Entry& e = entries_[pos];
+            if (e.slot == NOT_FOUND) return NOT_FOUND;
+            if (e.id == id) return e.slot;
+            pos = (pos + 1) & mask_;
+        }
+    }
+
+    // False if the id is already present
+    bool insert(uint64_t id, uint32_t slot) {
+        if ((size_ + 1) * 2 > mask_ + 1) rehash((mask_ + 1) * 2);
+        std::size_t pos = hash(id) & mask_;
+        while (entries_[pos].slot != NOT_FOUND) {
+            if (entries_[pos].id == id) return false;
+            pos = (pos + 1) & mask_;
+        }
+        entries_[pos] = {id, slot, 0};
+        ++size_;
+        return true;
+    }
+
+    // Backward-shift delete: pull later entries of the probe run into the
+    // hole, as long as that doesn't move them before their home position
+    bool erase(uint64_t id) {
+        std::size_t pos = hash(id) & mask_;
+        while (true) {
+            if (entries_[pos].slot == NOT_FOUND) return false;
+            if (entries_[pos].id == id) break;
+            pos = (pos + 1) & mask_;
+        }
+        std::size_t hole = pos;
+        std::size_t next = (hole + 1) & mask_;
+        while (entries_[next].slot != NOT_FOUND) {
+            std::size_t home = hash(entries_[next].id) & mask_;
+            // Move if home is not in the cyclic range (hole, next]
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                entries_[hole] = entries_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        entries_[hole].slot = NOT_FOUND;
+        --size_;
+        return true;
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return mask_ + 1; }
+    std::size_t memory_bytes() const { return capacity() * sizeof(Entry); }
+};
+
+// ===== INDEXED POOL =====
+template<typename T>
+class IndexedPool {
+private:
+    static constexpr uint32_t SLOTS_PER_CHUNK = 4096;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Slot {
+        alignas(T) char storage[sizeof(T)];
+        uint64_t id;
+        uint32_t next_free;
+        bool live;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    uint32_t free_head_ = NONE;
+    IdIndex index_;
+
+    Slot& slot(uint32_t i) { return chunks_[i / SLOTS_PER_CHUNK][i % SLOTS_PER_CHUNK]; }
+
+    void grow() {
+        uint32_t base = static_cast<uint32_t>(chunks_.size() * SLOTS_PER_CHUNK);
+        chunks_.push_back(std::make_unique<Slot[]>(SLOTS_PER_CHUNK));
+        Slot* chunk = chunks_.back().get();
+        for (uint32_t i = SLOTS_PER_CHUNK; i > 0; --i) {
+            chunk[i - 1].next_free = free_head_;
+            free_head_ = base + i - 1;
+        }
+    }
+
+    static Slot* slot_of(T* p) { return reinterpret_cast<Slot*>(p); }
+
+public:
+    explicit IndexedPool(std::size_t expected = 1024) : index_(expected) {}
+
+    IndexedPool(const IndexedPool&) = delete;
+    IndexedPool& operator=(const IndexedPool&) = delete;
+
+    ~IndexedPool() {
+        for (std::size_t c = 0; c < chunks_.size(); ++c) {
+            for (uint32_t i = 0; i < SLOTS_PER_CHUNK; ++i) {
+                if (chunks_[c][i].live) reinterpret_cast<T*>(chunks_[c][i].storage)->~T();
+            }
+        }
+    }
+
+    // nullptr if the id is already in the pool
+    template<typename... Args>
+    T* create(uint64_t id, Args&&... args) {
+        if (free_head_ == NONE) grow();
+        uint32_t s = free_head_;
+        if (!index_.insert(id, s)) return nullptr;
+        Slot& sl = slot(s);
+        free_head_ = sl.next_free;
+        sl.id = id;
+        sl.live = true;
+        return new (sl.storage) T(std::forward<Args>(args)...);
+    }
+
+    T* find(uint64_t id) {
+        uint32_t s = index_.find(id);
+        return s == IdIndex::NOT_FOUND ? nullptr : reinterpret_cast<T*>(slot(s).storage);
+    }
+
+    bool release(uint64_t id) {
+        uint32_t s = index_.find(id);
+        if (s == IdIndex::NOT_FOUND) return false;
+        index_.erase(id);
+        Slot& sl = slot(s);
+        reinterpret_cast<T*>(sl.storage)->~T();
+        sl.live = false;
+        sl.next_free = free_head_;
+        free_head_ = s;
+        return true;
+    }
+
+    // Release by pointer: the slot remembers its id
+    void release(T* p) { release(slot_of(p)->id); }
+
+    std::size_t size() const { return index_.size(); }
+    std::size_t index_memory_bytes() const { return index_.memory_bytes(); }
+};
+
+// ===== BASELINE: POOL + unordered_map<id, T*> =====
+template<typename T>
+class MappedPool {
+private:
+    union Slot {
+        alignas(T) char storage[sizeof(T)];
+        Slot* next;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot* free_head_ = nullptr;
+    std::unordered_map<uint64_t, T*> index_;
+
+    void grow() {
+        chunks_.push_back(std::make_unique<Slot[]>(4096));
+        Slot* chunk = chunks_.back().get();
+        for (std::size_t i = 4096; i > 0; --i) {
+            chunk[i - 1].next = free_head_;
+            free_head_ = &chunk[i - 1];
+        }
+    }
+
+public:
+    ~MappedPool() {
+        for (auto& [id, p] : index_) p->~T();
+    }
+
+    template<typename... Args>
+    T* create(uint64_t id, Args&&... args) {
+        if (index_.count(id)) return nullptr;
+        if (!free_head_) grow();
+        Slot* s = free_head_;
+        free_head_ = s->next;
+        T* p = new (s->storage) T(std::forward<Args>(args)...);
+        index_.emplace(id, p);
+        return p;
+    }
+
+    T* find(uint64_t id) {
+        auto it = index_.find(id);
+        return it == index_.end() ? nullptr : it->second;
+    }
+
+    bool release(uint64_t id) {
+        auto it = index_.find(id);
+        if (it == index_.end()) return false;
+        T* p = it->second;
+        index_.erase(it);
+        p->~T();
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = free_head_;
+        free_head_ = s;
+        return true;
+    }
+
+    std::size_t size() const { return index_.size(); }
+};
+
+// ===== BENCHMARK =====
+struct Transaction {
+    uint64_t account;
+    double amount;
+    char currency[8];
+};
+
+volatile double benchmark_sink;
+
+std::size_t heap_in_use() {
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+template<typename Fn>
+double time_ns_per_op(std::size_t ops, Fn&& fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+}
+
+template<typename Pool>
+void run_benchmark(const char* label, const std::vector<uint64_t>& ids, const std::vector<uint64_t>& probe_order,
+                   const std::vector<uint64_t>& missing) {
+    std::size_t heap_before = heap_in_use();
+    auto pool = std::make_unique<Pool>();
+    std::size_t n = ids.size();
+
+    double insert_ns = time_ns_per_op(n, [&] {
+        for (uint64_t id : ids) pool->create(id, Transaction{id % 1000, 1.0, "USD"});
+    });
+    std::size_t heap_after = heap_in_use();
+
+    double hit_ns = time_ns_per_op(n, [&] {
+        double sum = 0;
+        for (uint64_t id : probe_order) sum += pool->find(id)->amount;
+        benchmark_sink = sum;
+    });
+
+    double miss_ns = time_ns_per_op(missing.size(), [&] {
+        std::size_t found = 0;
+        for (uint64_t id : missing) found += pool->find(id) != nullptr;
+        benchmark_sink = static_cast<double>(found);
+    });
+
+    // Steady state: release one transaction, admit a new one
+    double churn_ns = time_ns_per_op(n / 2, [&] {
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            pool->release(probe_order[i]);
+            pool->create(missing[i], Transaction{i % 1000, 2.0, "EUR"});
+        }
+    });
+
+    std::cout << label << "\n";
+    std::cout << "  insert " << insert_ns << " ns, hit " << hit_ns << " ns, miss " << miss_ns
+              << " ns, release+create " << churn_ns << " ns";
+    if (heap_after > heap_before) {
+        std::cout << "; heap " << (heap_after - heap_before) / (1024 * 1024) << " MB";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << "=== Pool with Integrated Open-addressing Id Index ===\n\n";
+
+    {
+        IndexedPool<Transaction> pool;
+        pool.create(90001, Transaction{7, 25.0, "USD"});
+        Transaction* t = pool.create(90002, Transaction{8, 99.5, "EUR"});
+        std::cout << "Created ids 90001, 90002; duplicate 90001 -> "
+                  << (pool.create(90001, Transaction{9, 1.0, "GBP"}) ? "created" : "rejected") << "\n";
+        std::cout << "find(90002)->amount = " << pool.find(90002)->amount << "\n";
+        pool.release(t);
+        std::cout << "After release(ptr): find(90002) -> " << (pool.find(90002) ? "found" : "nullptr")
+                  << ", size " << pool.size() << "\n";
+    }
+
+    // Consistency check: random creates and releases against a reference map
+    {
+        IndexedPool<Transaction> pool(16);
+        std::unordered_map<uint64_t, double> reference;
+        std::mt19937_64 rng(5);
+        bool ok = true;
+        for (int i = 0; i < 200'000 && ok; ++i) {
+            uint64_t id = rng() % 20'000;  // Small id space: lots of collisions and re-use
+            if (rng() % 3 == 0) {
+                ok = pool.release(id) == (reference.erase(id) == 1);
+            } else if (!reference.count(id)) {
+                reference[id] = static_cast<double>(i);
+                ok = pool.create(id, Transaction{id, static_cast<double>(i), "USD"}) != nullptr;
+            }
+        }
+        for (auto& [id, amount] : reference) ok = ok && pool.find(id) && pool.find(id)->amount == amount;
+        std::cout << "200K random create/release ops vs reference map: " << (ok ? "consistent" : "MISMATCH")
+                  << "\n";
+    }
+
+    const std::size_t N = 1'000'000;
+    std::mt19937_64 rng(11);
+    std::vector<uint64_t> ids(N);
+    for (auto& id : ids) id = rng();
+    std::vector<uint64_t> probe_order = ids;
+    std::shuffle(probe_order.begin(), probe_order.end(), rng);
+    std::vector<uint64_t> missing(N);
+    for (auto& id : missing) id = rng();
+
+    std::cout << "\n=== Benchmark: " << N / 1000 << "K transactions with random 64-bit ids (per-op times) ===\n";
+    run_benchmark<IndexedPool<Transaction>>("Pool + flat id index:", ids, probe_order, missing);
+    run_benchmark<MappedPool<Transaction>>("Pool + std::unordered_map<id, T*>:", ids, probe_order, missing);
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- The flat index lives in one array: no node allocation per transaction\n";
+    std::cout << "- Lookups probe adjacent entries instead of chasing bucket -> node pointers\n";
+    std::cout << "- Backward-shift deletion keeps probe runs short under churn without tombstones\n";
+
+    return 0;
+}
@@ -0,0 +1,305 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ===== THREAD POOL =====
+// Minimal fork-join pool: run(tasks, fn) calls fn(task) for every task index
+// across the workers and the calling thread, and returns when all are done.
+// Static scheduling gives each thread one contiguous range of tasks; dynamic
+// scheduling lets threads grab the next task from a shared counter, which
+// evens out chunks that hold very different numbers of live objects.
+class ThreadPool {
+public:
+    enum class Schedule { Static, Dynamic };
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    std::function<void(std::size_t)> job_;   // Called with a participant id
+    std::size_t generation_ = 0;
+    std::size_t running_ = 0;
+    bool stopping_ = false;
+
+    void worker_loop(std::size_t id) {
+        std::size_t seen = 0;
+        while (true) {
+            std::function<void(std::size_t)> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                job = job_;
+            }
+            job(id);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--running_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(std::size_t threads) {
+        // The caller participates too, so start one fewer worker
+        for (std::size_t i = 1; i < threads; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size() + 1; }
+
+    template<typename Fn>
+    void run(std::size_t tasks, Schedule schedule, Fn&& fn) {
+        const std::size_t participants = size();
+        std::atomic<std::size_t> next{0};
+
+        auto body = [&](std::size_t id) {
+            if (schedule == Schedule::Static) {
+                std::size_t begin = tasks * id / participants;
+                std::size_t end = tasks * (id + 1) / participants;
+                for (std::size_t t = begin; t < end; ++t) fn(t);
+            } else {
+                for (std::size_t t = next.fetch_add(1, std::memory_order_relaxed); t < tasks;
+                     t = next.fetch_add(1, std::memory_order_relaxed)) {
+                    fn(t);
+                }
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = body;
+            running_ = workers_.size();
+            ++generation_;
+        }
+        start_cv_.notify_all();
+        body(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [&] { return running_ == 0; });
+    }
+};
+
+// ===== POOL WITH OCCUPANCY TRACKING =====
+// Same design as the pool in arena-vs-pool.cpp: chunks sorted by address,
+// one occupancy bit per block. Chunks are the unit of parallel work - each
+// is a contiguous run of memory, so threads never share cache lines of data
+// except at chunk boundaries.
+template<typename T>
+class PoolAllocator {
+private:
+    union Block {
+        alignas(T) char data[sizeof(T)];
+        Block* next;
+    };
+
+    struct Chunk {
+        std::unique_ptr<Block[]> blocks;
+        std::vector<uint64_t> occupied;
+    };
+
+    Block* freeList = nullptr;
+    std::vector<Chunk> chunks;
+    std::size_t objectsPerChunk;
+    std::size_t liveCount = 0;
+
+    void allocateChunk() {
+        Chunk chunk;
+        chunk.blocks = std::make_unique<Block[]>(objectsPerChunk);
+        chunk.occupied.assign((objectsPerChunk + 63) / 64, 0);
+        Block* blocks = chunk.blocks.get();
+        for (std::size_t i = 0; i < objectsPerChunk - 1; ++i) {
+            blocks[i].next = &blocks[i + 1];
+        }
+        blocks[objectsPerChunk - 1].next = freeList;
+        freeList = blocks;
+
+        auto pos = std::upper_bound(chunks.begin(), chunks.end(), blocks,
+            [](const Block* b, const Chunk& c) { return b < c.blocks.get(); });
+        chunks.insert(pos, std::move(chunk));
+    }
+
+    Chunk& chunkOf(const Block* block) {
+        auto it = std::upper_bound(chunks.begin(), chunks.end(), block,
+            [](const Block* b, const Chunk& c) { return b < c.blocks.get(); });
+        return *(it - 1);
+    }
+
+    template<typename Fn>
+    void visitChunk(Chunk& chunk, Fn& fn) {
+        Block* blocks = chunk.blocks.get();
+        for (std::size_t word = 0; word < chunk.occupied.size(); ++word) {
+            uint64_t bits = chunk.occupied[word];
+            while (bits) {
+                std::size_t index = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                fn(*reinterpret_cast<T*>(&blocks[index]));
+            }
+        }
+    }
+
+public:
+    explicit PoolAllocator(std::size_t objectsPerChunk = 4096) : objectsPerChunk(objectsPerChunk) {}
+
+    ~PoolAllocator() { destroy_all(); }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        if (!freeList) allocateChunk();
+        Block* block = freeList;
+        freeList = block->next;
+        Chunk& chunk = chunkOf(block);
+        std::size_t index = block - chunk.blocks.get();
+        chunk.occupied[index / 64] |= uint64_t(1) << (index % 64);
+        ++liveCount;
+        return new (block->data) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* ptr) {
+        Block* block = reinterpret_cast<Block*>(ptr);
+        Chunk& chunk = chunkOf(block);
+        std::size_t index = block - chunk.blocks.get();
+        chunk.occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+        ptr->~T();
+        block->next = freeList;
+        freeList = block;
+        --liveCount;
+    }
+
+    template<typename Fn>
+    void for_each_live(Fn&& fn) {
+        for (Chunk& chunk : chunks) visitChunk(chunk, fn);
+    }
+
+    // Chunk-partitioned parallel visit. fn runs concurrently on different
+    // objects, so it must only touch the object it is given. The pool itself
+    // must not be modified while this runs.
+    template<typename Fn>
+    void parallel_for_each_live(ThreadPool& threads, ThreadPool::Schedule schedule, Fn&& fn) {
+        threads.run(chunks.size(), schedule, [&](std::size_t c) { visitChunk(chunks[c], fn); });
+    }
+
+    void destroy_all() {
+        for_each_live([this](T& obj) { destroy(&obj); });
+    }
+
+    std::size_t getChunkCount() const { return chunks.size(); }
+    std::size_t getActiveObjects() const { return liveCount; }
+};
+
+// ===== BENCHMARK =====
+struct GameObject {
+    float x, y, z;
+    float vx, vy, vz;
+    int health;
+    char name[32];
+
+    GameObject(float px, float py, float pz)
+        : x(px), y(py), z(pz), vx(1.0f), vy(0.5f), vz(0.25f), health(100), name("Object") {}
+
+    void update(float dt) {
+        // A little arithmetic per object, as a physics step would have
+        for (int step = 0; step < 8; ++step) {
+            vy -= 9.8f * dt;
+            x += vx * dt;
+            y += vy * dt;
+            z += vz * dt;
+            if (y < 0) {
+                y = -y;
+                vy = -vy * 0.9f;
+                health -= 1;
+            }
+        }
+    }
+};
+
+long long time_updates(PoolAllocator<GameObject>& pool, ThreadPool& threads,
+                       ThreadPool::Schedule schedule, int frames) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        pool.parallel_for_each_live(threads, schedule, [](GameObject& obj) { obj.update(0.016f); });
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Parallel Iteration over Pool-resident Objects ===\n\n";
+
+    const std::size_t OBJECTS = 1000000;
+    const int FRAMES = 20;
+
+    PoolAllocator<GameObject> pool(4096);
+    std::vector<GameObject*> created;
+    created.reserve(OBJECTS);
+    for (std::size_t i = 0; i < OBJECTS; ++i) {
+        created.push_back(pool.create(float(i), float(i % 100), 0.0f));
+    }
+
+    // Free most of the objects in the second half of the pool so chunks carry
+    // uneven work - that is what dynamic scheduling is for
+    std::mt19937 rng(42);
+    for (std::size_t i = OBJECTS / 2; i < OBJECTS; ++i) {
+        if (rng() % 10 != 0) pool.destroy(created[i]);
+    }
+    created.clear();
+
+    std::cout << pool.getActiveObjects() << " live objects in " << pool.getChunkCount() << " chunks\n";
+
+    // Check the parallel visit covers exactly the live set
+    {
+        ThreadPool threads(4);
+        std::atomic<std::size_t> visited{0};
+        pool.parallel_for_each_live(threads, ThreadPool::Schedule::Dynamic,
+                                    [&](GameObject&) { visited.fetch_add(1, std::memory_order_relaxed); });
+        std::cout << "Parallel visit saw " << visited.load() << " objects\n";
+    }
+
+    std::cout << "\n=== Benchmark: " << FRAMES << " update frames ===\n";
+    // 1, 2, 4, ... threads, always finishing with every hardware thread
+    std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t n = 1; n < max_threads; n *= 2) thread_counts.push_back(n);
+    thread_counts.push_back(max_threads);
+
+    std::cout << "threads   static (us)   dynamic (us)\n";
+    for (std::size_t n : thread_counts) {
+        ThreadPool threads(n);
+        long long static_us = time_updates(pool, threads, ThreadPool::Schedule::Static, FRAMES);
+        long long dynamic_us = time_updates(pool, threads, ThreadPool::Schedule::Dynamic, FRAMES);
+        std::cout << n << "\t  " << static_us << "\t\t" << dynamic_us << "\n";
+    }
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Occupancy bits let the pool hand out its own live objects\n";
+    std::cout << "- Chunks are natural, contiguous units of parallel work\n";
+    std::cout << "- Dynamic scheduling absorbs chunks with uneven occupancy\n";
+
+    return 0;
+}
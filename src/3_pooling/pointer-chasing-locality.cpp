@@ -0,0 +1,486 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Pointer-chasing locality benchmark
+// Allocator comparisons usually time allocate/free only. This one times
+// what comes after: walking linked lists, trees and graphs whose nodes came
+// from a pool, a fresh heap, an aged heap (random churn first) and an aged
+// pool (free list shuffled). Where the nodes landed decides how many cache
+// and TLB misses each hop costs.
+//
+// Hardware counters come from perf_event_open when the kernel allows it
+// (perf_event_paranoid, containers and VMs often don't); otherwise only
+// times are reported.
+
+// ===== HARDWARE COUNTERS =====
+class PerfCounters {
+public:
+    static constexpr int COUNT = 3;
+
+private:
+    struct Counter {
+        const char* name;
+        uint32_t type;
+        uint64_t config;
+        int fd = -1;
+        uint64_t value = 0;
+    };
+
+    Counter counters_[COUNT] = {
+        {"cycles", 0, 0},
+        {"cache-misses", 0, 0},
+        {"dTLB-misses", 0, 0},
+    };
+
+public:
+    PerfCounters() {
+#ifdef __linux__
+        counters_[0].type = PERF_TYPE_HARDWARE;
+        counters_[0].config = PERF_COUNT_HW_CPU_CYCLES;
+        counters_[1].type = PERF_TYPE_HARDWARE;
+        counters_[1].config = PERF_COUNT_HW_CACHE_MISSES;
+        counters_[2].type = PERF_TYPE_HW_CACHE;
+        counters_[2].config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        for (Counter& c : counters_) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = c.type;
+            attr.config = c.config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            c.fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (Counter& c : counters_) {
+            if (c.fd >= 0) close(c.fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(int i) const { return counters_[i].fd >= 0; }
+    bool any_available() const { return available(0) || available(1) || available(2); }
+    const char* name(int i) const { return counters_[i].name; }
+    uint64_t value(int i) const { return counters_[i].value; }
+
+    void start() {
+#ifdef __linux__
+        for (Counter& c : counters_) {
+            if (c.fd < 0) continue;
+            ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (Counter& c : counters_) {
+            if (c.fd < 0) continue;
+            ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(c.fd, &c.value, sizeof(c.value)) != sizeof(c.value)) c.value = 0;
+        }
+#endif
+    }
+};
+
+// ===== ALLOCATORS UNDER TEST =====
+// Fixed-size block pool, grown in chunks; blocks are handed out in address order
+class FixedBlockPool {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 16384;
+
+    std::size_t block_size_;
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    FreeNode* free_head_ = nullptr;
+
+    void grow() {
+        chunks_.push_back(std::make_unique<std::byte[]>(block_size_ * BLOCKS_PER_CHUNK));
+        std::byte* chunk = chunks_.back().get();
+        for (std::size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(chunk + (i - 1) * block_size_);
+            node->next = free_head_;
+            free_head_ = node;
+        }
+    }
+
+public:
+    explicit FixedBlockPool(std::size_t block_size)
+        : block_size_((std::max(block_size, sizeof(FreeNode)) + alignof(std::max_align_t) - 1) &
+                      ~(alignof(std::max_align_t) - 1)) {}
+
+    void* allocate() {
+        if (!free_head_) grow();
+        FreeNode* node = free_head_;
+        free_head_ = node->next;
+        return node;
+    }
+
+    void deallocate(void* p) {
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_head_;
+        free_head_ = node;
+    }
+
+    // Simulate a long-running pool: take `count` blocks, return them in random order
+    void age(std::size_t count, std::mt19937_64& rng) {
+        std::vector<void*> blocks(count);
+        for (auto& b : blocks) b = allocate();
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        for (void* b : blocks) deallocate(b);
+    }
+};
+
+// Keeps a fragmented heap alive: many mixed-size blocks, most of them freed
+// again in random order, so new allocations land in scattered holes
+class HeapAger {
+private:
+    std::vector<void*> survivors_;
+
+public:
+    HeapAger(std::size_t blocks, std::mt19937_64& rng) {
+        std::uniform_int_distribution<std::size_t> size_dist(16, 160);
+        std::vector<void*> all(blocks);
+        for (auto& p : all) p = std::malloc(size_dist(rng));
+        std::shuffle(all.begin(), all.end(), rng);
+        std::size_t keep = blocks / 3;
+        for (std::size_t i = keep; i < blocks; ++i) std::free(all[i]);
+        all.resize(keep);
+        survivors_ = std::move(all);
+    }
+
+    ~HeapAger() {
+        for (void* p : survivors_) std::free(p);
+    }
+
+    HeapAger(const HeapAger&) = delete;
+    HeapAger& operator=(const HeapAger&) = delete;
+};
+
+// Policies the data structures allocate their nodes through
+struct HeapNodes {
+    explicit HeapNodes(std::size_t) {}
+    void* allocate(std::size_t bytes) { return ::operator new(bytes); }
+    void deallocate(void* p) { ::operator delete(p); }
+};
+
+struct PoolNodes {
+    FixedBlockPool pool;
+    explicit PoolNodes(std::size_t node_size) : pool(node_size) {}
+    void* allocate(std::size_t) { return pool.allocate(); }
+    void deallocate(void* p) { pool.deallocate(p); }
+};
+
+// ===== DATA STRUCTURES =====
+struct ListNode {
+    ListNode* next;
+    uint64_t value;
+};
+
+struct TreeNode {
+    TreeNode* left;
+    TreeNode* right;
+    uint64_t key;
+    uint64_t value;
+};
+
+struct GraphNode {
+    static constexpr int DEGREE = 6;
+    GraphNode* edges[DEGREE];
+    uint32_t id;
+    uint32_t visited_epoch;
+};
+
+template<typename Nodes>
+ListNode* build_list(Nodes& nodes, std::size_t count) {
+    ListNode* head = nullptr;
+    for (std::size_t i = 0; i < count; ++i) {
+        head = new (nodes.allocate(sizeof(ListNode))) ListNode{head, i};
+    }
+    return head;
+}
+
+uint64_t walk_list(const ListNode* head) {
+    uint64_t sum = 0;
+    for (const ListNode* n = head; n; n = n->next) sum += n->value;
+    return sum;
+}
+
+template<typename Nodes>
+void destroy_list(Nodes& nodes, ListNode* head) {
+    while (head) {
+        ListNode* next = head->next;
+        nodes.deallocate(head);
+        head = next;
+    }
+}
+
+// Unbalanced BST over random keys: expected depth O(log n)
+template<typename Nodes>
+TreeNode* build_tree(Nodes& nodes, const std::vector<uint64_t>& keys) {
+    TreeNode* root = nullptr;
+    for (uint64_t key : keys) {
+        TreeNode** link = &root;
+        while (*link) link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        *link = new (nodes.allocate(sizeof(TreeNode))) TreeNode{nullptr, nullptr, key, key * 3};
+    }
+    return root;
+}
+
+uint64_t lookup_tree(const TreeNode* root, const std::vector<uint64_t>& probes) {
+    uint64_t sum = 0;
+    for (uint64_t key : probes) {
+        const TreeNode* n = root;
+        while (n && n->key != key) n = key < n->key ? n->left : n->right;
+        if (n) sum += n->value;
+    }
+    return sum;
+}
+
+template<typename Nodes>
+void destroy_tree(Nodes& nodes, TreeNode* root) {
+    std::vector<TreeNode*> stack{root};
+    while (!stack.empty()) {
+        TreeNode* n = stack.back();
+        stack.pop_back();
+        if (!n) continue;
+        stack.push_back(n->left);
+        stack.push_back(n->right);
+        nodes.deallocate(n);
+    }
+}
+
+// Random graph where most edges point to nearby ids (like a mesh or a
+// social graph with communities), so allocation order matters
+template<typename Nodes>
+std::vector<GraphNode*> build_graph(Nodes& nodes, std::size_t count, std::mt19937_64& rng) {
+    std::vector<GraphNode*> graph(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        graph[i] = new (nodes.allocate(sizeof(GraphNode))) GraphNode{{}, static_cast<uint32_t>(i), 0};
+    }
+    std::uniform_int_distribution<std::size_t> near(0, 64);
+    std::uniform_int_distribution<std::size_t> far(0, count - 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int e = 0; e < GraphNode::DEGREE; ++e) {
+            std::size_t target = e == 0 ? far(rng) : (i + near(rng)) % count;
+            graph[i]->edges[e] = graph[target];
+        }
+    }
+    return graph;
+}
+
+// Breadth-first search from node 0; the queue is reused across runs
+uint64_t bfs_graph(GraphNode* start, uint32_t epoch, std::vector<GraphNode*>& queue) {
+    queue.clear();
+    queue.push_back(start);
+    start->visited_epoch = epoch;
+    uint64_t sum = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        GraphNode* n = queue[head];
+        sum += n->id;
+        for (GraphNode* next : n->edges) {
+            if (next->visited_epoch != epoch) {
+                next->visited_epoch = epoch;
+                queue.push_back(next);
+            }
+        }
+    }
+    return sum;
+}
+
+template<typename Nodes>
+void destroy_graph(Nodes& nodes, std::vector<GraphNode*>& graph) {
+    for (GraphNode* n : graph) nodes.deallocate(n);
+    graph.clear();
+}
+
+// ===== BENCHMARK =====
+volatile uint64_t benchmark_sink;
+
+struct Measurement {
+    double build_ms;
+    double traverse_ms;
+    uint64_t counters[PerfCounters::COUNT];
+};
+
+// Best of several traversals; counters are taken from the best run
+template<typename Fn>
+void measure_traversal(Fn&& traverse, int repeats, PerfCounters& perf, Measurement& m) {
+    m.traverse_ms = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        perf.start();
+        auto start = std::chrono::high_resolution_clock::now();
+        benchmark_sink = traverse(r + 1);
+        auto end = std::chrono::high_resolution_clock::now();
+        perf.stop();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (ms < m.traverse_ms) {
+            m.traverse_ms = ms;
+            for (int i = 0; i < PerfCounters::COUNT; ++i) m.counters[i] = perf.value(i);
+        }
+    }
+}
+
+void print_header(const PerfCounters& perf) {
+    std::cout << std::left << std::setw(12) << "allocator" << std::right << std::setw(11) << "build ms"
+              << std::setw(13) << "traverse ms" << std::setw(12) << "ns/op";
+    for (int i = 0; i < PerfCounters::COUNT; ++i) {
+        if (perf.available(i)) std::cout << std::setw(16) << (std::string(perf.name(i)) + "/op");
+    }
+    std::cout << "\n";
+}
+
+void print_row(const char* label, const Measurement& m, std::size_t visits, const PerfCounters& perf) {
+    std::cout << std::left << std::setw(12) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(11) << m.build_ms << std::setw(13) << m.traverse_ms << std::setw(12)
+              << m.traverse_ms * 1e6 / static_cast<double>(visits);
+    for (int i = 0; i < PerfCounters::COUNT; ++i) {
+        if (perf.available(i)) {
+            std::cout << std::setw(16) << static_cast<double>(m.counters[i]) / static_cast<double>(visits);
+        }
+    }
+    std::cout << "\n";
+}
+
+const std::size_t LIST_NODES = 1'000'000;
+const std::size_t TREE_NODES = 200'000;
+const std::size_t TREE_PROBES = 200'000;
+const std::size_t GRAPH_NODES = 500'000;
+const std::size_t AGING_BLOCKS = 2'000'000;
+const int REPEATS = 5;
+
+template<typename Nodes>
+Measurement run_list(Nodes& nodes, PerfCounters& perf) {
+    Measurement m{};
+    auto start = std::chrono::high_resolution_clock::now();
+    ListNode* head = build_list(nodes, LIST_NODES);
+    m.build_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    measure_traversal([&](int) { return walk_list(head); }, REPEATS, perf, m);
+    destroy_list(nodes, head);
+    return m;
+}
+
+template<typename Nodes>
+Measurement run_tree(Nodes& nodes, PerfCounters& perf, const std::vector<uint64_t>& keys,
+                     const std::vector<uint64_t>& probes) {
+    Measurement m{};
+    auto start = std::chrono::high_resolution_clock::now();
+    TreeNode* root = build_tree(nodes, keys);
+    m.build_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    measure_traversal([&](int) { return lookup_tree(root, probes); }, REPEATS, perf, m);
+    destroy_tree(nodes, root);
+    return m;
+}
+
+template<typename Nodes>
+Measurement run_graph(Nodes& nodes, PerfCounters& perf) {
+    Measurement m{};
+    std::mt19937_64 rng(7);
+    std::vector<GraphNode*> queue;
+    queue.reserve(GRAPH_NODES);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<GraphNode*> graph = build_graph(nodes, GRAPH_NODES, rng);
+    m.build_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    measure_traversal([&](int epoch) { return bfs_graph(graph[0], static_cast<uint32_t>(epoch), queue); },
+                      REPEATS, perf, m);
+    destroy_graph(nodes, graph);
+    return m;
+}
+
+// Runs one structure on all four allocator setups
+template<typename Node, typename Run>
+void compare(const char* title, std::size_t visits, PerfCounters& perf, Run&& run) {
+    std::cout << "\n--- " << title << " ---\n";
+    print_header(perf);
+
+    {
+        PoolNodes nodes(sizeof(Node));
+        print_row("pool", run(nodes), visits, perf);
+    }
+    {
+        HeapNodes nodes(sizeof(Node));
+        print_row("heap", run(nodes), visits, perf);
+    }
+    std::mt19937_64 rng(42);
+    {
+        HeapAger ager(AGING_BLOCKS, rng);
+        HeapNodes nodes(sizeof(Node));
+        print_row("aged heap", run(nodes), visits, perf);
+    }
+    {
+        PoolNodes nodes(sizeof(Node));
+        nodes.pool.age(visits, rng);
+        print_row("aged pool", run(nodes), visits, perf);
+    }
+}
+
+int main() {
+    std::cout << "=== Pointer-chasing Locality: Pool vs Heap vs Aged Heap ===\n";
+
+    PerfCounters perf;
+    if (perf.any_available()) {
+        std::cout << "Hardware counters:";
+        for (int i = 0; i < PerfCounters::COUNT; ++i) {
+            std::cout << " " << perf.name(i) << (perf.available(i) ? "" : " (unavailable)");
+        }
+        std::cout << "\n";
+    } else {
+        std::cout << "Hardware counters unavailable (perf_event_open refused); reporting times only\n";
+    }
+    std::cout << "Aged heap: " << AGING_BLOCKS << " mixed-size blocks, two thirds freed at random\n";
+    std::cout << "Aged pool: free list shuffled by a random-order free of every block\n";
+
+    compare<ListNode>("Linked list walk (1M nodes)", LIST_NODES, perf,
+                      [&](auto& nodes) { return run_list(nodes, perf); });
+
+    std::mt19937_64 key_rng(1);
+    std::vector<uint64_t> keys(TREE_NODES);
+    for (auto& k : keys) k = key_rng();
+    std::vector<uint64_t> probes(TREE_PROBES);
+    for (auto& p : probes) p = keys[key_rng() % keys.size()];
+    compare<TreeNode>("Binary tree lookups (200K nodes, 200K probes)", TREE_PROBES, perf,
+                      [&](auto& nodes) { return run_tree(nodes, perf, keys, probes); });
+
+    compare<GraphNode>("Graph BFS (500K nodes, degree 6)", GRAPH_NODES, perf,
+                       [&](auto& nodes) { return run_graph(nodes, perf); });
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Each read of a scattered structure pays again; an allocation is paid once\n";
+    std::cout << "- A fresh heap and a fresh pool both place nodes in allocation order\n";
+    std::cout << "- After churn the heap scatters nodes; every hop risks a cache/TLB miss\n";
+    std::cout << "- A pool only stays compact if its free list does (see free-list-policies)\n";
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <new>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+// Pool state shared by every copy (and rebind) of an allocator handle.
+// The block size is fixed by the first allocation, so a std::list<T> - which
+// only ever allocates rebound list nodes - still gets a pool sized for nodes.
+class SharedPoolState {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 1024;
+
+    FreeNode* free_head_ = nullptr;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t block_size_ = 0;
+
+    void allocate_chunk() {
+        auto chunk = std::make_unique<char[]>(BLOCKS_PER_CHUNK * block_size_);
+        char* current = chunk.get();
+        for (std::size_t i = 0; i < BLOCKS_PER_CHUNK; ++i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(current + i * block_size_);
+            node->next = free_head_;
+            free_head_ = node;
+        }
+        chunks_.push_back(std::move(chunk));
+    }
+
+public:
+    void* allocate(std::size_t bytes) {
+        if (block_size_ == 0) {
+            std::size_t align = alignof(std::max_align_t);
+            block_size_ = ((bytes < sizeof(FreeNode) ? sizeof(FreeNode) : bytes) + align - 1) & ~(align - 1);
+        }
+        if (bytes > block_size_) {
+            return ::operator new(bytes);  // Not our size class
+        }
+        if (!free_head_) {
+            allocate_chunk();
+        }
+        FreeNode* node = free_head_;
+        free_head_ = node->next;
+        return node;
+    }
+
+    void deallocate(void* p, std::size_t bytes) noexcept {
+        if (bytes > block_size_) {
+            ::operator delete(p);
+            return;
+        }
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_head_;
+        free_head_ = node;
+    }
+
+    std::size_t get_chunk_count() const { return chunks_.size(); }
+};
+
+// Allocator handle with shared ownership of its pool.
+// Propagate = true gives the container the right traits: a moved or swapped
+// container takes the pool handle with it, so the operation is a pointer swap.
+// Propagate = false reproduces the old behaviour for comparison: the target
+// keeps its own pool and every element is moved into freshly allocated memory.
+template<typename T, bool Propagate = true>
+class PoolHandle {
+private:
+    std::shared_ptr<SharedPoolState> state_;
+
+    template<typename U, bool P>
+    friend class PoolHandle;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = PoolHandle<U, Propagate>;
+    };
+
+    PoolHandle() : state_(std::make_shared<SharedPoolState>()) {}
+
+    // Copies and rebinds share the pool - O(1), just a reference count
+    PoolHandle(const PoolHandle&) noexcept = default;
+
+    template<typename U>
+    PoolHandle(const PoolHandle<U, Propagate>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(state_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        state_->deallocate(p, n * sizeof(T));
+    }
+
+    // O(1): two handles are equal when they share a pool
+    template<typename U>
+    bool operator==(const PoolHandle<U, Propagate>& other) const noexcept {
+        return state_ == other.state_;
+    }
+
+    template<typename U>
+    bool operator!=(const PoolHandle<U, Propagate>& other) const noexcept {
+        return !(*this == other);
+    }
+
+    std::size_t get_chunk_count() const { return state_->get_chunk_count(); }
+};
+
+struct Transaction {
+    long id;
+    double amount;
+    char currency[8];
+
+    Transaction(long i = 0, double a = 0.0) : id(i), amount(a), currency{"USD"} {}
+};
+
+volatile double benchmark_sink;  // Keeps benchmark results observable
+
+// Batches travel through a pipeline of stages. Each stage owns a working
+// list built on its own pool and move-assigns the next batch into it before
+// handing it on to the next stage's queue.
+template<bool Propagate>
+long long run_queue_benchmark(std::size_t batches, std::size_t batch_size, std::size_t stages) {
+    using Alloc = PoolHandle<Transaction, Propagate>;
+    using Batch = std::list<Transaction, Alloc>;
+
+    Alloc producer_pool;
+    std::vector<std::queue<Batch>> queues(stages + 1);
+
+    for (std::size_t b = 0; b < batches; ++b) {
+        Batch batch(producer_pool);
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            batch.emplace_back(static_cast<long>(b * batch_size + i), i * 0.5);
+        }
+        queues[0].push(std::move(batch));  // Move construction is always O(1)
+    }
+
+    std::vector<Alloc> stage_pools(stages);
+    double total = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t stage = 0; stage < stages; ++stage) {
+        Batch working(stage_pools[stage]);
+        while (!queues[stage].empty()) {
+            working = std::move(queues[stage].front());  // The operation that differs
+            queues[stage].pop();
+            total += working.front().amount;
+            queues[stage + 1].push(std::move(working));
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark_sink = total;
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Shared Pool Handles and Container Moves ===\n\n";
+
+    PoolHandle<Transaction> pool_a;
+    PoolHandle<Transaction> pool_b;
+    PoolHandle<Transaction> copy_of_a = pool_a;
+
+    std::cout << "copy_of_a == pool_a: " << std::boolalpha << (copy_of_a == pool_a) << "\n";
+    std::cout << "pool_a == pool_b:    " << (pool_a == pool_b) << "\n";
+
+    std::cout << "\n--- Move assignment across pools ---\n";
+    std::list<Transaction, PoolHandle<Transaction>> first(pool_a);
+    std::list<Transaction, PoolHandle<Transaction>> second(pool_b);
+    for (int i = 0; i < 5; ++i) {
+        first.emplace_back(i, i * 10.0);
+    }
+    const Transaction* node_before = &first.front();
+    second = std::move(first);
+    std::cout << "Elements kept their addresses: " << (node_before == &second.front()) << "\n";
+    std::cout << "second now uses pool_a: " << (second.get_allocator() == pool_a) << "\n";
+
+    std::cout << "\n--- Swap across pools ---\n";
+    std::list<Transaction, PoolHandle<Transaction>> third(pool_b);
+    third.emplace_back(99, 99.0);
+    second.swap(third);
+    std::cout << "After swap, second.front().id = " << second.front().id
+              << ", third has " << third.size() << " elements\n";
+
+    std::cout << "\n=== Benchmark: moving batches through a queue ===\n";
+    const std::size_t BATCHES = 2000;
+    const std::size_t BATCH_SIZE = 500;
+    const std::size_t STAGES = 4;
+    long long element_wise = run_queue_benchmark<false>(BATCHES, BATCH_SIZE, STAGES);
+    long long pointer_swap = run_queue_benchmark<true>(BATCHES, BATCH_SIZE, STAGES);
+
+    std::cout << BATCHES << " batches of " << BATCH_SIZE << " transactions through "
+              << STAGES << " stages\n";
+    std::cout << "Without propagation (element-wise): " << element_wise << " microseconds\n";
+    std::cout << "With propagation (pointer swap):    " << pointer_swap << " microseconds\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Handles that share one pool can compare equal in O(1)\n";
+    std::cout << "- propagate_on_container_* lets moves and swaps carry the pool along\n";
+    std::cout << "- Shared ownership keeps the pool alive as long as any container uses it\n";
+
+    return 0;
+}
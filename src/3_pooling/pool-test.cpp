@@ -1,21 +1,100 @@
 #include <memory>
 #include <iostream>
 #include <vector>
+#include <list>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 
-template<typename T, size_t PoolSize = 64>
-class PoolAllocator {
-private:
-    alignas(T) char pool_[PoolSize * sizeof(T)];
+#include "../common/alloc_result.hpp"
+
+// Shared by every copy of the allocator and by every rebind of it, so a
+// node container's internal allocator is the same pool as its own. The
+// container and its node allocator ask for different sizes, so the state
+// keeps one free list of PoolSize blocks per block size, created the first
+// time that size is allocated
+template<size_t PoolSize>
+class PoolState {
+public:
+    static constexpr size_t MAX_SIZE_CLASSES = 4;
     
+private:
     struct FreeNode {
         FreeNode* next;
     };
     
-    FreeNode* free_head_ = nullptr;
+    struct SizeClass {
+        size_t block_size = 0;  // 0 while the slot is unused
+        std::unique_ptr<char[]> storage;
+        FreeNode* free_head = nullptr;
+    };
+    
+    SizeClass classes_[MAX_SIZE_CLASSES];
+    
+    static size_t block_size_for(size_t bytes) {
+        size_t align = alignof(std::max_align_t);
+        return ((bytes < sizeof(FreeNode) ? sizeof(FreeNode) : bytes) + align - 1) & ~(align - 1);
+    }
+    
+    SizeClass* find(size_t block_size) {
+        for (SizeClass& c : classes_) {
+            if (c.block_size == block_size) return &c;
+        }
+        return nullptr;
+    }
+    
+    void initialize(SizeClass& c, size_t block_size) {
+        c.storage = std::make_unique<char[]>(PoolSize * block_size);
+        c.block_size = block_size;
+        // Initialize free list
+        for (size_t i = PoolSize; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(c.storage.get() + (i - 1) * block_size);
+            node->next = c.free_head;
+            c.free_head = node;
+        }
+    }
+    
+public:
+    // nullptr when that size's blocks are exhausted or every size class is taken
+    void* allocate(size_t bytes) {
+        size_t block_size = block_size_for(bytes);
+        SizeClass* c = find(block_size);
+        if (!c) {
+            c = find(0);
+            if (!c) return nullptr;
+            initialize(*c, block_size);
+        }
+        if (!c->free_head) return nullptr;
+        FreeNode* node = c->free_head;
+        c->free_head = node->next;
+        return node;
+    }
+    
+    // bytes must be what the block was allocated with
+    void deallocate(void* p, size_t bytes) noexcept {
+        SizeClass* c = find(block_size_for(bytes));
+        if (!c) return;
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = c->free_head;
+        c->free_head = node;
+    }
+};
+
+template<typename T, size_t PoolSize = 64>
+class PoolAllocator {
+private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "blocks are max_align_t aligned");
+    
+    std::shared_ptr<PoolState<PoolSize>> state_;
+    
+    template<typename U, size_t S>
+    friend class PoolAllocator;
 
 public:
     using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
     
     // Required for C++11/14 compatibility
     template<typename U>
@@ -23,48 +102,36 @@ public:
         using other = PoolAllocator<U, PoolSize>;
     };
     
-    PoolAllocator() {
-        // Initialize free list
-        char* current = pool_;
-        for (size_t i = 0; i < PoolSize - 1; ++i) {
-            reinterpret_cast<FreeNode*>(current)->next = 
-                reinterpret_cast<FreeNode*>(current + sizeof(T));
-            current += sizeof(T);
-        }
-        reinterpret_cast<FreeNode*>(current)->next = nullptr;
-        free_head_ = reinterpret_cast<FreeNode*>(pool_);
-    }
+    PoolAllocator() : state_(std::make_shared<PoolState<PoolSize>>()) {}
     
-    // Copy constructor (each allocator has its own pool)
-    PoolAllocator(const PoolAllocator&) : PoolAllocator() {}
+    // Copy constructor (copies share the pool)
+    PoolAllocator(const PoolAllocator&) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator&) noexcept = default;
     
-    // Rebind constructor
+    // Rebind constructor - shares the pool, so A(B(a)) == a
     template<typename U>
-    PoolAllocator(const PoolAllocator<U, PoolSize>&) : PoolAllocator() {}
+    PoolAllocator(const PoolAllocator<U, PoolSize>& other) noexcept : state_(other.state_) {}
     
     T* allocate(std::size_t n) {
-        if (n != 1 || !free_head_) {
-            throw std::bad_alloc();
+        void* p = n == 1 ? state_->allocate(sizeof(T)) : nullptr;
+        if (!p) {
+            throw_bad_alloc();
         }
-        
-        T* result = reinterpret_cast<T*>(free_head_);
-        free_head_ = free_head_->next;
-        return result;
+        return static_cast<T*>(p);
     }
     
     void deallocate(T* p, std::size_t n) noexcept {
         if (n != 1 || !p) return;
-        
-        FreeNode* node = reinterpret_cast<FreeNode*>(p);
-        node->next = free_head_;
-        free_head_ = node;
+        state_->deallocate(p, sizeof(T));
     }
     
-    bool operator==(const PoolAllocator& other) const noexcept {
-        return this == &other;
+    template<typename U>
+    bool operator==(const PoolAllocator<U, PoolSize>& other) const noexcept {
+        return state_ == other.state_;
     }
     
-    bool operator!=(const PoolAllocator& other) const noexcept {
+    template<typename U>
+    bool operator!=(const PoolAllocator<U, PoolSize>& other) const noexcept {
         return !(*this == other);
     }
 };
@@ -109,5 +176,19 @@ int main() {
         std::allocator_traits<PoolAllocator<TestObject>>::deallocate(pool_alloc, obj, 1);
     }
     
+    std::cout << "\n=== Rebinding shares the pool ===\n";
+    PoolAllocator<int> ints;
+    ints.deallocate(ints.allocate(1), 1);  // ints first, then list nodes of another size
+    PoolAllocator<double> rebound(ints);
+    std::cout << "PoolAllocator<double>(ints) == ints: " << (rebound == ints ? "yes" : "no") << "\n";
+    std::cout << "PoolAllocator<int>(rebound) == ints: " << (PoolAllocator<int>(rebound) == ints ? "yes" : "no") << "\n";
+    
+    // std::list allocates nodes through a rebound copy - the same pool
+    std::list<int, PoolAllocator<int>> numbers(ints);
+    for (int i = 0; i < 5; ++i) numbers.push_back(i);
+    std::list<int, PoolAllocator<int>> moved(std::move(numbers));
+    std::cout << "list nodes from the shared pool, moved list size " << moved.size()
+              << ", allocators equal: " << (moved.get_allocator() == ints ? "yes" : "no") << "\n";
+    
     return 0;
 }
\ No newline at end of file
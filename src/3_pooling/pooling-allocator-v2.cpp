@@ -1,35 +1,151 @@
 #include <memory>
 #include <vector>
+#include <list>
 #include <iostream>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <cassert>
 
-template<typename T, size_t PoolSize = 1024>
-class PoolAllocator {
-private:
-    // Pool storage - aligned for T
-    alignas(T) char pool_[PoolSize * sizeof(T)];
+#include "../common/alloc_result.hpp"
+
+// Why try_allocate() came back empty
+enum class AllocError {
+    Exhausted,         // Every block is in use
+    UnsupportedCount,  // The pool only hands out single objects
+    TooManySizes,      // Every size class of the shared pool is taken
+};
+
+const char* alloc_error_name(AllocError error) {
+    switch (error) {
+        case AllocError::Exhausted: return "pool exhausted";
+        case AllocError::UnsupportedCount: return "only single-object allocation is supported";
+        case AllocError::TooManySizes: return "no free size class for this type";
+    }
+    return "unknown";
+}
+
+// std::expected<T*, AllocError> on C++23, the shared stand-in otherwise
+template<typename T>
+using AllocResult = BasicAllocResult<T, AllocError>;
+
+// Pool storage lives outside the allocator so that every copy the
+// containers make shares it - copies are handles, not new pools. Rebinds
+// share it too: std::list and std::map allocate their nodes through a
+// rebound copy, and that copy must compare equal to the original. The
+// element type and the node type differ in size, so the state keeps one
+// pool of PoolSize blocks per block size, created on first use
+template<size_t PoolSize>
+class PoolState {
+public:
+    static constexpr size_t MAX_SIZE_CLASSES = 4;
     
+private:
     // Free list - simple stack of available blocks
     struct FreeNode {
         FreeNode* next;
     };
     
-    FreeNode* free_head_ = nullptr;
-    size_t allocated_count_ = 0;
+    struct SizeClass {
+        size_t block_size = 0;  // 0 while the slot is unused
+        std::unique_ptr<char[]> storage;
+        FreeNode* free_head = nullptr;
+        size_t allocated_count = 0;
+    };
+    
+    SizeClass classes_[MAX_SIZE_CLASSES];
+    
+    static size_t block_size_for(size_t bytes) noexcept {
+        size_t align = alignof(std::max_align_t);
+        return ((bytes < sizeof(FreeNode) ? sizeof(FreeNode) : bytes) + align - 1) & ~(align - 1);
+    }
+    
+    SizeClass* find(size_t block_size) noexcept {
+        for (SizeClass& c : classes_) {
+            if (c.block_size == block_size) return &c;
+        }
+        return nullptr;
+    }
+    
+    const SizeClass* find(size_t block_size) const noexcept {
+        return const_cast<PoolState*>(this)->find(block_size);
+    }
     
-    void initialize_pool() {
-        // Initialize free list - thread through the pool
-        char* current = pool_;
-        for (size_t i = 0; i < PoolSize - 1; ++i) {
-            reinterpret_cast<FreeNode*>(current)->next = 
-                reinterpret_cast<FreeNode*>(current + sizeof(T));
-            current += sizeof(T);
+    bool initialize(SizeClass& c, size_t block_size) noexcept {
+        c.storage.reset(new (std::nothrow) char[PoolSize * block_size]);
+        if (!c.storage) return false;
+        c.block_size = block_size;
+        // Initialize free list - thread through the pool in address order
+        for (size_t i = PoolSize; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(c.storage.get() + (i - 1) * block_size);
+            node->next = c.free_head;
+            c.free_head = node;
         }
-        // Last node points to nullptr
-        reinterpret_cast<FreeNode*>(current)->next = nullptr;
-        free_head_ = reinterpret_cast<FreeNode*>(pool_);
+        return true;
+    }
+    
+public:
+    AllocResult<void> allocate(size_t bytes) noexcept {
+        size_t block_size = block_size_for(bytes);
+        SizeClass* c = find(block_size);
+        if (!c) {
+            c = find(0);
+            if (!c) {
+                return alloc_failure(AllocError::TooManySizes);
+            }
+            if (!initialize(*c, block_size)) {
+                return alloc_failure(AllocError::Exhausted);
+            }
+        }
+        if (c->free_head == nullptr) {
+            return alloc_failure(AllocError::Exhausted);
+        }
+        
+        // Pop from free list
+        FreeNode* node = c->free_head;
+        c->free_head = node->next;
+        ++c->allocated_count;
+        return static_cast<void*>(node);
+    }
+    
+    // p must be owned by the size class for bytes (see owns)
+    void deallocate(void* p, size_t bytes) noexcept {
+        // Push back to free list
+        SizeClass* c = find(block_size_for(bytes));
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = c->free_head;
+        c->free_head = node;
+        --c->allocated_count;
+    }
+    
+    bool owns(const void* p, size_t bytes) const noexcept {
+        const SizeClass* c = find(block_size_for(bytes));
+        const char* b = static_cast<const char*>(p);
+        return c && b >= c->storage.get() && b < c->storage.get() + PoolSize * c->block_size;
+    }
+    
+    // Blocks in use for one size, or across every size
+    size_t allocated_count(size_t bytes) const noexcept {
+        const SizeClass* c = find(block_size_for(bytes));
+        return c ? c->allocated_count : 0;
     }
+    
+    size_t allocated_count() const noexcept {
+        size_t total = 0;
+        for (const SizeClass& c : classes_) total += c.allocated_count;
+        return total;
+    }
+};
+
+template<typename T, size_t PoolSize = 1024>
+class PoolAllocator {
+private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "blocks are max_align_t aligned");
+    
+    std::shared_ptr<PoolState<PoolSize>> state_;
+    
+    template<typename U, size_t S>
+    friend class PoolAllocator;
 
 public:
     // Required type aliases for allocator
@@ -37,6 +153,13 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     
+    // The pool travels with the container on assignment and swap, so a
+    // container move is a pointer swap instead of element-wise moves
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    
     // C++17 and later: rebind is automatically provided by allocator_traits
     // But for older compilers, we need to provide it explicitly
     template<typename U>
@@ -45,40 +168,40 @@ public:
     };
     
     // Constructor
-    PoolAllocator() {
-        initialize_pool();
-    }
+    PoolAllocator() : state_(std::make_shared<PoolState<PoolSize>>()) {}
     
-    // Copy constructor (required for container compatibility)
-    PoolAllocator(const PoolAllocator& other) noexcept {
-        initialize_pool(); // Each allocator has its own pool
-    }
+    // Copy constructor (required for container compatibility) - shares the pool
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
     
-    // Rebind constructor (for different types)
+    // Rebind constructor (for different types) - shares the pool, so A(B(a)) == a
     template<typename U>
-    PoolAllocator(const PoolAllocator<U, PoolSize>&) {
-        initialize_pool();
-    }
+    PoolAllocator(const PoolAllocator<U, PoolSize>& other) noexcept : state_(other.state_) {}
     
-    // Allocate memory
-    T* allocate(std::size_t n) {
+    // Exception-free allocation - failure is a value, and nothing is logged
+    AllocResult<T> try_allocate(std::size_t n = 1) noexcept {
         if (n != 1) {
-            throw std::bad_alloc(); // This simple pool only handles single objects
+            return alloc_failure(AllocError::UnsupportedCount); // This simple pool only handles single objects
         }
         
-        if (free_head_ == nullptr) {
-            throw std::bad_alloc(); // Pool exhausted
+        AllocResult<void> block = state_->allocate(sizeof(T));
+        if (!block) {
+            return alloc_failure(block.error());
+        }
+        return static_cast<T*>(*block);
+    }
+    
+    // Allocate memory
+    T* allocate(std::size_t n) {
+        AllocResult<T> result = try_allocate(n);
+        if (!result) {
+            throw_bad_alloc();
         }
         
-        // Pop from free list
-        T* result = reinterpret_cast<T*>(free_head_);
-        free_head_ = free_head_->next;
-        ++allocated_count_;
-        
-        std::cout << "Pool allocated block #" << allocated_count_ 
-                  << " at " << static_cast<void*>(result) << std::endl;
+        std::cout << "Pool allocated block #" << state_->allocated_count(sizeof(T)) 
+                  << " at " << static_cast<void*>(*result) << std::endl;
         
-        return result;
+        return *result;
     }
     
     // Deallocate memory
@@ -86,18 +209,13 @@ public:
         if (n != 1 || p == nullptr) return;
         
         // Verify pointer is within our pool
-        if (p < reinterpret_cast<T*>(pool_) || 
-            p >= reinterpret_cast<T*>(pool_ + sizeof(pool_))) {
+        if (!state_->owns(p, sizeof(T))) {
             return; // Not our memory, ignore
         }
         
-        // Push back to free list
-        FreeNode* node = reinterpret_cast<FreeNode*>(p);
-        node->next = free_head_;
-        free_head_ = node;
-        --allocated_count_;
+        state_->deallocate(p, sizeof(T));
         
-        std::cout << "Pool deallocated block, " << allocated_count_ 
+        std::cout << "Pool deallocated block, " << state_->allocated_count(sizeof(T)) 
                   << " still allocated" << std::endl;
     }
     
@@ -114,18 +232,22 @@ public:
         p->~T();
     }
     
-    // Equality comparison (required)
-    bool operator==(const PoolAllocator& other) const noexcept {
-        return this == &other; // Same pool instance
+    // Equality comparison (required) - O(1), equal when sharing a pool,
+    // including across rebinds
+    template<typename U>
+    bool operator==(const PoolAllocator<U, PoolSize>& other) const noexcept {
+        return state_ == other.state_; // Same pool
     }
     
-    bool operator!=(const PoolAllocator& other) const noexcept {
+    template<typename U>
+    bool operator!=(const PoolAllocator<U, PoolSize>& other) const noexcept {
         return !(*this == other);
     }
     
-    // Statistics
-    size_t allocated_count() const { return allocated_count_; }
-    size_t available_count() const { return PoolSize - allocated_count_; }
+    // Statistics - for blocks of T's size, except total_allocated_count
+    size_t allocated_count() const { return state_->allocated_count(sizeof(T)); }
+    size_t available_count() const { return PoolSize - state_->allocated_count(sizeof(T)); }
+    size_t total_allocated_count() const { return state_->allocated_count(); }
     constexpr size_t pool_size() const { return PoolSize; }
 };
 
@@ -178,10 +300,28 @@ int main() {
     
     std::cout << "\nFinal available: " << pool_alloc.available_count() << std::endl;
     
+    std::cout << "\n=== Exhausting the pool with try_allocate ===\n";
+    // No exceptions involved, so this also runs in -fno-exceptions builds
+    std::vector<TestObject*> held;
+    for (;;) {
+        AllocResult<TestObject> slot = pool_alloc.try_allocate();
+        if (!slot) {
+            std::cout << "try_allocate failed after " << held.size() << " blocks: "
+                      << alloc_error_name(slot.error()) << std::endl;
+            break;
+        }
+        held.push_back(*slot);
+    }
+    std::cout << "try_allocate(2): " << alloc_error_name(pool_alloc.try_allocate(2).error()) << std::endl;
+    for (TestObject* p : held) {
+        std::allocator_traits<PoolAllocator<TestObject, 8>>::deallocate(pool_alloc, p, 1);
+    }
+    
     std::cout << "\n=== Testing with std::vector ===\n";
     // Using the pool allocator with a standard container
     std::vector<TestObject, PoolAllocator<TestObject, 8>> pool_vector(pool_alloc);
     
+#if defined(__cpp_exceptions)
     try {
         pool_vector.emplace_back(100, 99.9);
         pool_vector.emplace_back(200, 199.9);
@@ -193,6 +333,33 @@ int main() {
     } catch (const std::exception& e) {
         std::cout << "Exception: " << e.what() << std::endl;
     }
+#else
+    // Growing to two elements asks for allocate(2), which would abort here
+    pool_vector.emplace_back(100, 99.9);
+    std::cout << "Vector contents:\n";
+    std::cout << "  id=" << pool_vector[0].id << ", value=" << pool_vector[0].value << std::endl;
+    std::cout << "Built without exceptions: skipping the second emplace_back" << std::endl;
+#endif
+    
+    std::cout << "\n=== Testing with std::list (rebinds to its node type) ===\n";
+    // Same pool as above, already used for TestObject: list nodes are larger
+    // and get their own size class. The rebound node allocator shares the pool.
+    PoolAllocator<TestObject, 8>& list_pool = pool_alloc;
+    {
+        std::list<TestObject, PoolAllocator<TestObject, 8>> pool_list(list_pool);
+        pool_list.emplace_back(1, 1.0);
+        pool_list.emplace_back(2, 2.0);
+        
+        using NodeAlloc = std::allocator_traits<PoolAllocator<TestObject, 8>>::rebind_alloc<double>;
+        std::cout << "Rebound copy compares equal: " << (NodeAlloc(list_pool) == list_pool ? "yes" : "no") << std::endl;
+        std::cout << "Blocks taken from the shared pool (vector element + list nodes): "
+                  << list_pool.total_allocated_count() << std::endl;
+        
+        // Equal allocators, so moving the list steals its nodes
+        std::list<TestObject, PoolAllocator<TestObject, 8>> moved(std::move(pool_list));
+        std::cout << "After move: " << moved.size() << " elements, still "
+                  << list_pool.total_allocated_count() << " blocks in use" << std::endl;
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -57,6 +57,23 @@ struct MyObject {
     }
 };
 
+void fill_list(TracingPoolAllocator<MyObject>& my_alloc) {
+    // std::list<MyObject> has elements of type MyObject (T = MyObject)
+    // But internally, it needs to allocate list nodes which have a different type!
+    // Something like: struct ListNode { MyObject data; ListNode* next; ListNode* prev; }
+    
+    std::list<MyObject, TracingPoolAllocator<MyObject>> my_list(my_alloc);
+    
+    std::cout << "\n3. Adding elements to list:\n";
+    my_list.emplace_back(42);
+    my_list.emplace_back(84);
+    
+    std::cout << "\nList contents:\n";
+    for (const auto& obj : my_list) {
+        std::cout << "  Value: " << obj.value << "\n";
+    }
+}
+
 int main() {
     std::cout << "=== Understanding Rebind: When U != T ===\n\n";
     
@@ -66,25 +83,15 @@ int main() {
     std::cout << "\n2. Using with std::list<MyObject> (this will trigger rebind!):\n";
     std::cout << "   std::list needs to allocate list nodes, not just MyObject\n";
     
+#if defined(__cpp_exceptions)
     try {
-        // std::list<MyObject> has elements of type MyObject (T = MyObject)
-        // But internally, it needs to allocate list nodes which have a different type!
-        // Something like: struct ListNode { MyObject data; ListNode* next; ListNode* prev; }
-        
-        std::list<MyObject, TracingPoolAllocator<MyObject>> my_list(my_alloc);
-        
-        std::cout << "\n3. Adding elements to list:\n";
-        my_list.emplace_back(42);
-        my_list.emplace_back(84);
-        
-        std::cout << "\nList contents:\n";
-        for (const auto& obj : my_list) {
-            std::cout << "  Value: " << obj.value << "\n";
-        }
-        
+        fill_list(my_alloc);
     } catch (const std::exception& e) {
         std::cout << "Exception: " << e.what() << "\n";
     }
+#else
+    fill_list(my_alloc);
+#endif
     
     std::cout << "\n=== What Happened Behind the Scenes ===\n";
     std::cout << "1. You created TracingPoolAllocator<MyObject> (T = MyObject)\n";
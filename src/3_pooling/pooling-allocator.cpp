@@ -1,9 +1,13 @@
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <iostream>
 #include <list>
 #include <memory>
 #include <vector>
 
+#include "../common/alloc_result.hpp"
+
 template <typename T> class PoolAllocator {
 public:
   using value_type = T;
@@ -25,7 +29,7 @@ public:
   // Allocate memory for `n` elements
   pointer allocate(size_type n) {
     if (freeList_.empty() || n > availableBlocks()) {
-      throw std::bad_alloc(); // Not enough memory
+      throw_bad_alloc(); // Not enough memory
     }
 
     pointer result = freeList_.front();
@@ -82,21 +86,29 @@ private:
   }
 };
 
-int main() {
-  try {
-    std::vector<int, PoolAllocator<int>> vec(PoolAllocator<int>(10));
+void run_demo() {
+  std::vector<int, PoolAllocator<int>> vec(PoolAllocator<int>(10));
 
-    vec.push_back(1);
-    vec.push_back(2);
-    vec.push_back(3);
+  vec.push_back(1);
+  vec.push_back(2);
+  vec.push_back(3);
 
-    for (size_t i = 0; i < vec.size(); ++i) {
-      std::cout << "Element " << i + 1 << ": " << vec[i]
-                << " (Address: " << &vec[i] << ")" << std::endl;
-    }
+  for (size_t i = 0; i < vec.size(); ++i) {
+    std::cout << "Element " << i + 1 << ": " << vec[i]
+              << " (Address: " << &vec[i] << ")" << std::endl;
+  }
+}
+
+int main() {
+#if defined(__cpp_exceptions)
+  try {
+    run_demo();
   } catch (const std::bad_alloc &) {
     std::cerr << "Memory allocation failed!" << std::endl;
   }
+#else
+  run_demo(); // Allocation failure aborts
+#endif
 
   return 0;
 }
\ No newline at end of file
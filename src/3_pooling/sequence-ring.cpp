@@ -0,0 +1,439 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// LMAX-style ring of preallocated transaction slots
+// The README flow is receive -> hold -> process -> release. With a pool plus
+// a queue, every transaction allocates a slot, is pushed through one queue
+// per stage and is freed at the end. Each hand-off takes a lock.
+//
+// A disruptor-style ring skips all of that:
+// - Every slot is constructed once, up front, and reused in place.
+// - Ownership comes from sequence numbers. The producer claims sequences,
+//   fills the slots and publishes its cursor. Each consumer stage follows
+//   the cursor, or the stages it depends on, and then publishes its own
+//   sequence.
+// - "Release" happens implicitly: once the slowest final stage passes a
+//   slot, the producer may reuse it.
+// - Stages handle everything that is available in one batch, so a stage
+//   that falls behind catches up with one cursor store instead of one per
+//   item.
+//
+// This ring has a single producer. Multiple producers would claim with
+// fetch_add and need per-slot availability flags.
+
+// ===== SEQUENCE =====
+// Every cursor gets its own cache line. The producer and each consumer write
+// to different lines, so publishing never invalidates a neighbour's cursor.
+struct alignas(64) Sequence {
+    std::atomic<int64_t> value{-1};  // Last sequence this party has finished with
+
+    int64_t get() const { return value.load(std::memory_order_acquire); }
+    void set(int64_t v) { value.store(v, std::memory_order_release); }
+};
+static_assert(sizeof(Sequence) == 64, "Sequence must fill exactly one cache line");
+
+// Spin briefly, then yield. A waiting stage must never starve the stage it
+// waits on, which matters most when there are fewer cores than threads.
+class SpinYieldWait {
+private:
+    int spins_ = 0;
+
+public:
+    void idle() {
+        if (++spins_ < 64) return;
+        std::this_thread::yield();
+    }
+};
+
+inline int64_t min_sequence(const std::vector<const Sequence*>& sequences) {
+    int64_t lowest = INT64_MAX;
+    for (const Sequence* s : sequences) lowest = std::min(lowest, s->get());
+    return lowest;
+}
+
+// ===== RING =====
+template<typename T, std::size_t Size>
+class SequenceRing {
+    static_assert(Size > 0 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+private:
+    std::unique_ptr<T[]> entries_;            // Constructed once, reused in place
+    Sequence cursor_;                         // Last published sequence
+    std::vector<const Sequence*> gating_;     // Final consumer stages
+    // Producer-only state, kept away from the cursor that consumers poll
+    alignas(64) int64_t claimed_ = -1;        // Last claimed sequence
+    int64_t cached_gate_ = -1;                // Last known minimum of gating_
+    uint64_t producer_waits_ = 0;             // Claims that found the ring full
+
+public:
+    SequenceRing() : entries_(std::make_unique<T[]>(Size)) {}
+
+    SequenceRing(const SequenceRing&) = delete;
+    SequenceRing& operator=(const SequenceRing&) = delete;
+
+    // The producer never laps a gating sequence by more than Size slots.
+    // Gate only on the last stages; earlier stages are implicitly ahead of them.
+    void add_gating(const Sequence& sequence) { gating_.push_back(&sequence); }
+
+    T& operator[](int64_t sequence) { return entries_[static_cast<std::size_t>(sequence) & (Size - 1)]; }
+
+    // Claim n consecutive slots and return the highest sequence claimed.
+    // Waits while that would overwrite a slot the slowest consumer still holds.
+    int64_t claim(int64_t n = 1) {
+        int64_t high = claimed_ + n;
+        int64_t wrap_point = high - static_cast<int64_t>(Size);
+        if (wrap_point > cached_gate_) {
+            int64_t gate = min_sequence(gating_);
+            if (wrap_point > gate) {
+                ++producer_waits_;
+                SpinYieldWait wait;
+                do wait.idle();
+                while (wrap_point > (gate = min_sequence(gating_)));
+            }
+            cached_gate_ = gate;
+        }
+        claimed_ = high;
+        return high;
+    }
+
+    // Make every slot up to and including `high` visible to consumers
+    void publish(int64_t high) { cursor_.set(high); }
+
+    const Sequence& cursor() const { return cursor_; }
+    uint64_t get_producer_waits() const { return producer_waits_; }
+    static constexpr std::size_t capacity() { return Size; }
+};
+
+// What a consumer stage waits on. That is either the ring cursor or the
+// sequences of the stages it depends on.
+class SequenceBarrier {
+private:
+    std::vector<const Sequence*> dependencies_;
+
+public:
+    explicit SequenceBarrier(std::vector<const Sequence*> dependencies) : dependencies_(std::move(dependencies)) {}
+
+    // Highest sequence >= `sequence` that every dependency has finished
+    int64_t wait_for(int64_t sequence) const {
+        SpinYieldWait wait;
+        int64_t available;
+        while ((available = min_sequence(dependencies_)) < sequence) wait.idle();
+        return available;
+    }
+};
+
+struct StageStats {
+    uint64_t events = 0;
+    uint64_t batches = 0;
+    int64_t max_batch = 0;
+};
+
+// Run one consumer stage until it has handled `last`. Everything the barrier
+// reports as available is handled as one batch, followed by a single store.
+template<typename Ring, typename Handler>
+StageStats run_stage(Ring& ring, const SequenceBarrier& barrier, Sequence& sequence, int64_t last,
+                     Handler handler) {
+    StageStats stats;
+    int64_t next = sequence.get() + 1;
+    while (next <= last) {
+        int64_t available = std::min(barrier.wait_for(next), last);
+        stats.max_batch = std::max(stats.max_batch, available - next + 1);
+        ++stats.batches;
+        for (; next <= available; ++next) handler(ring[next], next);
+        sequence.set(available);
+    }
+    stats.events = static_cast<uint64_t>(last + 1);
+    return stats;
+}
+
+// ===== TRANSACTION =====
+struct Transaction {
+    uint64_t id = 0;
+    uint64_t account = 0;
+    int64_t amount_cents = 0;
+    uint64_t checksum = 0;
+    bool valid = false;
+    char payload[88] = {};  // Raw request bytes held until processing
+};
+
+inline uint64_t checksum_of(const Transaction& t) {
+    uint64_t h = t.id * 0x9E3779B97F4A7C15ull ^ t.account;
+    h ^= static_cast<uint64_t>(t.amount_cents) + (h << 6) + (h >> 2);
+    for (char c : t.payload) h = h * 31 + static_cast<unsigned char>(c);
+    return h;
+}
+
+// receive: fill a slot in place
+inline void receive(Transaction& t, uint64_t id) {
+    t.id = id;
+    t.account = id % 977;
+    t.amount_cents = static_cast<int64_t>(id % 10'000) - 2'500;
+    t.payload[0] = static_cast<char>(id);
+    t.payload[sizeof(t.payload) - 1] = static_cast<char>(id >> 8);
+    t.valid = false;
+    t.checksum = 0;
+}
+
+// ===== BASELINE: CHUNKED POOL + BOUNDED QUEUE =====
+// Mutex-protected free list that grows a chunk at a time, as a shared
+// transaction pool would
+template<typename T, std::size_t ChunkSlots = 256>
+class ChunkedPool {
+private:
+    union Slot {
+        alignas(T) char data[sizeof(T)];
+        Slot* next;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot* free_head_ = nullptr;
+    std::mutex mutex_;
+
+    void grow() {
+        chunks_.push_back(std::make_unique<Slot[]>(ChunkSlots));
+        Slot* chunk = chunks_.back().get();
+        for (std::size_t i = 0; i < ChunkSlots; ++i) {
+            chunk[i].next = free_head_;
+            free_head_ = &chunk[i];
+        }
+    }
+
+public:
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_head_) grow();
+            slot = free_head_;
+            free_head_ = slot->next;
+        }
+        return new (slot->data) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* p) {
+        p->~T();
+        Slot* slot = reinterpret_cast<Slot*>(p);
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot->next = free_head_;
+        free_head_ = slot;
+    }
+
+    std::size_t get_chunk_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunks_.size();
+    }
+};
+
+// Bounded so that the baseline applies the same backpressure as the ring
+template<typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items_;
+    std::size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+        items_.push_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    T pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !items_.empty(); });
+        T item = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return item;
+    }
+};
+
+// ===== DEMO =====
+// Diamond dependency graph: journal and validate both follow the producer,
+// and process waits for both of them. The producer is gated by process only.
+void run_diamond_demo() {
+    const int64_t count = 40;
+    SequenceRing<Transaction, 8> ring;
+    Sequence journal_seq, validate_seq, process_seq;
+    ring.add_gating(process_seq);
+
+    SequenceBarrier from_cursor({&ring.cursor()});
+    SequenceBarrier from_both({&journal_seq, &validate_seq});
+
+    uint64_t journaled = 0;
+    uint64_t out_of_order = 0;
+    uint64_t not_ready = 0;
+    int64_t balance = 0;
+    StageStats journal_stats, validate_stats, process_stats;
+
+    std::thread journal([&] {
+        journal_stats = run_stage(ring, from_cursor, journal_seq, count - 1, [&](Transaction& t, int64_t) {
+            journaled += t.id;
+        });
+    });
+    std::thread validate([&] {
+        validate_stats = run_stage(ring, from_cursor, validate_seq, count - 1, [&](Transaction& t, int64_t) {
+            t.checksum = checksum_of(t);
+            t.valid = t.amount_cents != 0;
+        });
+    });
+    std::thread process([&] {
+        int64_t expected = 0;
+        process_stats = run_stage(ring, from_both, process_seq, count - 1, [&](Transaction& t, int64_t seq) {
+            if (static_cast<int64_t>(t.id) != seq || seq != expected++) ++out_of_order;
+            if (t.checksum != checksum_of(t)) ++not_ready;  // Validator must already have run
+            if (t.valid) balance += t.amount_cents;
+        });
+    });
+
+    for (int64_t seq = 0; seq < count;) {
+        int64_t batch = std::min<int64_t>(3, count - seq);
+        int64_t high = ring.claim(batch);
+        for (; seq <= high; ++seq) receive(ring[seq], static_cast<uint64_t>(seq));
+        ring.publish(high);
+    }
+
+    journal.join();
+    validate.join();
+    process.join();
+
+    uint64_t expected_journal = static_cast<uint64_t>(count * (count - 1) / 2);
+    std::cout << count << " transactions through an 8-slot ring\n";
+    std::cout << "journal:  " << journal_stats.batches << " batches (largest " << journal_stats.max_batch
+              << "), id sum " << journaled << (journaled == expected_journal ? " (ok)\n" : " (WRONG)\n");
+    std::cout << "validate: " << validate_stats.batches << " batches (largest " << validate_stats.max_batch << ")\n";
+    std::cout << "process:  " << process_stats.batches << " batches (largest " << process_stats.max_batch
+              << "), balance " << balance << " cents\n";
+    std::cout << "out of order: " << out_of_order << ", processed before validation: " << not_ready
+              << ", producer waits on a full ring: " << ring.get_producer_waits() << "\n";
+}
+
+// ===== BENCHMARK =====
+const int64_t TRANSACTIONS = 2'000'000;
+const std::size_t RING_SIZE = 1024;
+const int64_t CLAIM_BATCH = 32;
+
+volatile double benchmark_sink;
+
+// receive -> validate -> process, with each step on its own thread
+void benchmark_ring() {
+    auto ring = std::make_unique<SequenceRing<Transaction, RING_SIZE>>();
+    Sequence validate_seq, process_seq;
+    ring->add_gating(process_seq);
+    SequenceBarrier from_cursor({&ring->cursor()});
+    SequenceBarrier from_validate({&validate_seq});
+
+    int64_t balance = 0;
+    StageStats validate_stats, process_stats;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::thread validate([&] {
+        validate_stats = run_stage(*ring, from_cursor, validate_seq, TRANSACTIONS - 1, [](Transaction& t, int64_t) {
+            t.checksum = checksum_of(t);
+            t.valid = t.amount_cents != 0;
+        });
+    });
+    std::thread process([&] {
+        process_stats = run_stage(*ring, from_validate, process_seq, TRANSACTIONS - 1, [&](Transaction& t, int64_t) {
+            if (t.valid) balance += t.amount_cents ^ static_cast<int64_t>(t.checksum & 1);
+        });
+    });
+
+    for (int64_t seq = 0; seq < TRANSACTIONS;) {
+        int64_t high = ring->claim(std::min(CLAIM_BATCH, TRANSACTIONS - seq));
+        for (; seq <= high; ++seq) receive((*ring)[seq], static_cast<uint64_t>(seq));
+        ring->publish(high);
+    }
+    validate.join();
+    process.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark_sink = static_cast<double>(balance);
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    std::cout << "Sequence ring (" << RING_SIZE << " preallocated slots):\n";
+    std::cout << "  " << us << " us, " << (us * 1000.0 / TRANSACTIONS) << " ns/transaction, balance " << balance
+              << "\n";
+    std::cout << "  avg batch: validate " << validate_stats.events / validate_stats.batches << ", process "
+              << process_stats.events / process_stats.batches << "; producer waits "
+              << ring->get_producer_waits() << "\n";
+}
+
+void benchmark_pool_and_queue() {
+    ChunkedPool<Transaction> pool;
+    BoundedQueue<Transaction*> to_validate(RING_SIZE / 2);
+    BoundedQueue<Transaction*> to_process(RING_SIZE / 2);
+
+    int64_t balance = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::thread validate([&] {
+        for (int64_t i = 0; i < TRANSACTIONS; ++i) {
+            Transaction* t = to_validate.pop();
+            t->checksum = checksum_of(*t);
+            t->valid = t->amount_cents != 0;
+            to_process.push(t);
+        }
+    });
+    std::thread process([&] {
+        for (int64_t i = 0; i < TRANSACTIONS; ++i) {
+            Transaction* t = to_process.pop();
+            if (t->valid) balance += t->amount_cents ^ static_cast<int64_t>(t->checksum & 1);
+            pool.destroy(t);
+        }
+    });
+
+    for (int64_t seq = 0; seq < TRANSACTIONS; ++seq) {
+        Transaction* t = pool.create();
+        receive(*t, static_cast<uint64_t>(seq));
+        to_validate.push(t);
+    }
+    validate.join();
+    process.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark_sink = static_cast<double>(balance);
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    std::cout << "Chunked pool + bounded queues:\n";
+    std::cout << "  " << us << " us, " << (us * 1000.0 / TRANSACTIONS) << " ns/transaction, balance " << balance
+              << "\n";
+    std::cout << "  " << pool.get_chunk_count() << " chunks allocated, 2 locks + 1 alloc/free per transaction\n";
+}
+
+int main() {
+    std::cout << "=== LMAX-style Sequence Ring ===\n\n";
+
+    std::cout << "--- Diamond: journal || validate -> process ---\n";
+    run_diamond_demo();
+
+    std::cout << "\n=== Benchmark: " << TRANSACTIONS << " transactions, receive -> validate -> process ===\n";
+    std::cout << "(" << std::thread::hardware_concurrency() << " hardware threads)\n";
+    benchmark_ring();
+    benchmark_pool_and_queue();
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Slots are built once and reused in place; release is just a consumer cursor moving past\n";
+    std::cout << "- Each hand-off is one release store on a cache-line-padded cursor, not a lock\n";
+    std::cout << "- Lagging stages catch up in batches, so the cost per item drops under load\n";
+    std::cout << "- Gating on the slowest final stage gives backpressure without a separate bound\n";
+
+    return 0;
+}
@@ -1,7 +1,10 @@
 #include <iostream>
 #include <cstddef>
+#include <cstdlib>
 #include <new>
 
+#include "../common/alloc_result.hpp"
+
 template<typename T, size_t PoolSize = 8>
 class SimplePoolAllocator {
 private:
@@ -41,7 +44,7 @@ public:
     T* allocate() {
         if (free_head_ == nullptr) {
             std::cout << "Pool exhausted!" << std::endl;
-            throw std::bad_alloc();
+            throw_bad_alloc();
         }
         
         // Pop from free list
@@ -140,6 +143,7 @@ int main() {
     }
     
     std::cout << "\n=== Testing pool exhaustion ===\n";
+#if defined(__cpp_exceptions)
     try {
         // Try to allocate more than the pool size
         for (int i = 0; i < 10; ++i) {
@@ -150,6 +154,15 @@ int main() {
     } catch (const std::bad_alloc& e) {
         std::cout << "Caught expected exception: pool exhausted\n";
     }
+#else
+    // allocate() aborts on exhaustion here, so stop once the pool is empty
+    for (int i = 0; i < 10 && pool.available_count() > 0; ++i) {
+        TestObject* obj = pool.allocate();
+        new(obj) TestObject(999, 999.9);
+        std::cout << "Allocated extra object " << i << std::endl;
+    }
+    std::cout << "Pool exhausted (built without exceptions, stopped before allocate() aborts)\n";
+#endif
     
     std::cout << "\nFinal pool state - Available: " << pool.available_count() 
               << " / " << pool.pool_size() << std::endl;
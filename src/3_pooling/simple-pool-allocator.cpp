@@ -1,8 +1,31 @@
 #include <iostream>
 #include <memory>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <new>
 
+#include "../common/alloc_result.hpp"
+
+// Why try_allocate() came back empty
+enum class AllocError {
+    Exhausted,         // Every block is in use
+    UnsupportedCount,  // This pool only hands out single objects
+};
+
+const char* alloc_error_name(AllocError error) {
+    switch (error) {
+        case AllocError::Exhausted: return "pool exhausted";
+        case AllocError::UnsupportedCount: return "only single-object allocation is supported";
+    }
+    return "unknown";
+}
+
+// std::expected<T*, AllocError> on C++23, the shared stand-in otherwise
+template<typename T>
+using AllocResult = BasicAllocResult<T, AllocError>;
+
 template<typename T, std::size_t PoolSize = 8>
 class SimplePoolAllocator {
 private:
@@ -43,27 +66,39 @@ public:
         initialize_pool();
     }
     
-    // Standard allocator interface - allocate n objects
-    T* allocate(std::size_t n) {
+    // Exception-free allocation - failure is a value, and nothing is logged
+    AllocResult<T> try_allocate(std::size_t n = 1) noexcept {
         if (n != 1) {
-            std::cout << "This simple pool only supports single object allocation" << std::endl;
-            throw std::bad_alloc();
+            return alloc_failure(AllocError::UnsupportedCount);
         }
         
         if (free_head_ == nullptr) {
-            std::cout << "Pool exhausted!" << std::endl;
-            throw std::bad_alloc();
+            return alloc_failure(AllocError::Exhausted);
         }
         
         // Pop from free list
         T* result = reinterpret_cast<T*>(free_head_);
         free_head_ = free_head_->next;
         ++allocated_count_;
+        return result;
+    }
+    
+    // Standard allocator interface - allocate n objects
+    T* allocate(std::size_t n) {
+        AllocResult<T> result = try_allocate(n);
+        if (!result) {
+            if (result.error() == AllocError::UnsupportedCount) {
+                std::cout << "This simple pool only supports single object allocation" << std::endl;
+            } else {
+                std::cout << "Pool exhausted!" << std::endl;
+            }
+            throw_bad_alloc();
+        }
         
         std::cout << "Allocated block #" << allocated_count_ 
-                  << " at " << static_cast<void*>(result) << std::endl;
+                  << " at " << static_cast<void*>(*result) << std::endl;
         
-        return result;
+        return *result;
     }
     
     // Standard allocator interface - deallocate n objects
@@ -116,6 +151,86 @@ struct TestObject {
     }
 };
 
+// ===== BENCHMARK =====
+// Failure-heavy workloads: bursts of attempts against an 8-block pool, so
+// everything past the 8th attempt in a burst fails. Both columns pop the free
+// list the same way and neither logs: the throwing side wraps try_allocate()
+// and throws std::bad_alloc on failure, which the caller catches, while
+// try_allocate() just returns the error. The 0% row is the no-failure
+// baseline. Output is muted only for the untimed releases.
+const int ATTEMPTS = 200'000;
+
+volatile double benchmark_sink;
+
+using BenchPool = SimplePoolAllocator<std::uint64_t, 8>;
+
+struct MutedOutput {
+    MutedOutput() { std::cout.setstate(std::ios::badbit); }
+    ~MutedOutput() { std::cout.clear(); }
+};
+
+// Nanoseconds per attempt
+template<typename TryOne>
+double run_bursts(BenchPool& pool, int burst, TryOne try_one) {
+    MutedOutput muted;
+    std::uint64_t* held[8];
+    std::size_t failures = 0;
+    std::chrono::nanoseconds elapsed{0};
+    
+    for (int done = 0; done < ATTEMPTS; done += burst) {
+        int count = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < burst; ++i) {
+            if (std::uint64_t* p = try_one(pool)) held[count++] = p;
+            else ++failures;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+        // Releasing the burst is not timed
+        for (int i = 0; i < count; ++i) pool.deallocate(held[i], 1);
+    }
+    
+    benchmark_sink = static_cast<double>(failures);
+    return elapsed.count() / double(ATTEMPTS);
+}
+
+void run_failure_benchmark() {
+    BenchPool pool;
+    
+    auto with_expected = [](BenchPool& p) -> std::uint64_t* {
+        AllocResult<std::uint64_t> result = p.try_allocate();
+        return result ? *result : nullptr;
+    };
+#if defined(__cpp_exceptions)
+    // allocate() without its logging: the only difference is how failure travels
+    auto allocate_or_throw = [](BenchPool& p) -> std::uint64_t* {
+        AllocResult<std::uint64_t> result = p.try_allocate();
+        if (!result) throw_bad_alloc();
+        return *result;
+    };
+    auto with_catch = [&](BenchPool& p) -> std::uint64_t* {
+        try {
+            return allocate_or_throw(p);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    };
+#endif
+    
+    std::cout << "try_allocate() returns " << ALLOC_RESULT_KIND << "\n";
+    std::cout << "failure rate | throw + catch | try_allocate()   (ns per attempt, 0% = baseline)\n";
+    for (int burst : {8, 10, 16, 80}) {
+        int failure_percent = (burst - 8) * 100 / burst;
+        std::cout << "    " << failure_percent << "%" << (failure_percent < 10 ? "      " : "     ") << "| ";
+#if defined(__cpp_exceptions)
+        std::cout << run_bursts(pool, burst, with_catch);
+#else
+        std::cout << "(no exceptions)";
+#endif
+        std::cout << " | " << run_bursts(pool, burst, with_expected) << "\n";
+    }
+}
+
 int main() {
     std::cout << "=== Pool Allocator with allocator_traits Demo ===\n";
     std::cout << "This example shows standard-compliant allocation using allocator_traits\n\n";
@@ -159,6 +274,7 @@ int main() {
     }
     
     std::cout << "\n=== Testing pool exhaustion ===\n";
+#if defined(__cpp_exceptions)
     try {
         // Try to allocate more than the pool size
         for (int i = 0; i < 10; ++i) {
@@ -169,16 +285,36 @@ int main() {
     } catch (const std::bad_alloc& e) {
         std::cout << "Caught expected exception: pool exhausted\n";
     }
+#else
+    std::cout << "Built without exceptions: allocate() would abort, using try_allocate() only\n";
+#endif
+    
+    std::cout << "\n=== Testing pool exhaustion with try_allocate ===\n";
+    // Works the same with or without exception support
+    for (int i = 0;; ++i) {
+        AllocResult<TestObject> slot = pool.try_allocate();
+        if (!slot) {
+            std::cout << "try_allocate failed after " << i << " more objects: "
+                      << alloc_error_name(slot.error()) << std::endl;
+            break;
+        }
+        AllocTraits::construct(pool, *slot, 1000 + i, 0.5);
+    }
+    std::cout << "try_allocate(2): " << alloc_error_name(pool.try_allocate(2).error()) << std::endl;
     
     std::cout << "\nFinal pool state - Available: " << pool.available_count() 
               << " / " << pool.pool_size() << std::endl;
     
+    std::cout << "\n=== Benchmark: " << ATTEMPTS << " allocation attempts, 8-block pool ===\n";
+    run_failure_benchmark();
+    
     std::cout << "\nKey benefits of allocator_traits:\n";
     std::cout << "- Standard-compliant interface\n";
     std::cout << "- Provides default construct/destroy implementations\n";
     std::cout << "- Less template code to write\n";
     std::cout << "- Compatible with standard containers (if rebind added)\n";
     std::cout << "- Forward compatible with future C++ standards\n";
+    std::cout << "- try_allocate() makes exhaustion a cheap value, even in -fno-exceptions builds\n";
     
     return 0;
 }
\ No newline at end of file
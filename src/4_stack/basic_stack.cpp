@@ -1,8 +1,21 @@
 #include <iostream>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <cassert>
 #include <new>
 
+#include "../common/alloc_result.hpp"
+
+// Why try_allocate() came back empty
+enum class AllocError {
+    OutOfSpace,  // Not enough room left above the stack top
+};
+
+// std::expected<T*, AllocError> on C++23, the shared stand-in otherwise
+template<typename T>
+using AllocResult = BasicAllocResult<T, AllocError>;
+
 // Stack Allocator - allocates memory in LIFO (Last In, First Out) order
 // Key characteristics:
 // - Very fast allocation (just increment a pointer)
@@ -33,31 +46,54 @@ public:
     StackAllocator(const StackAllocator&) = delete;
     StackAllocator& operator=(const StackAllocator&) = delete;
     
-    // Allocate raw memory from the stack
-    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+    // Exception-free allocation - running out of space is a value, nothing is logged
+    AllocResult<void> try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
         // Calculate properly aligned offset
         std::size_t aligned_offset = align_up(current_offset_, alignment);
         
-        // Check if we have enough space
-        if (aligned_offset + bytes > total_size_) {
-            std::cout << "Stack allocator out of memory! Requested: " << bytes 
-                      << " bytes, available: " << (total_size_ - aligned_offset) << " bytes\n";
-            throw std::bad_alloc();
+        // Check if we have enough space (written so the sum can't wrap)
+        if (aligned_offset > total_size_ || bytes > total_size_ - aligned_offset) {
+            return alloc_failure(AllocError::OutOfSpace);
         }
         
-        // Return pointer to the allocated memory
-        void* ptr = memory_ + aligned_offset;
         current_offset_ = aligned_offset + bytes;
+        return static_cast<void*>(memory_ + aligned_offset);
+    }
+    
+    // Type-safe exception-free allocation
+    template<typename T>
+    AllocResult<T> try_allocate(std::size_t count = 1) noexcept {
+        if (count > SIZE_MAX / sizeof(T)) {
+            return alloc_failure(AllocError::OutOfSpace);  // sizeof(T) * count would wrap
+        }
+        AllocResult<void> result = try_allocate(sizeof(T) * count, alignof(T));
+        if (!result) {
+            return alloc_failure(result.error());
+        }
+        return static_cast<T*>(*result);
+    }
+    
+    // Allocate raw memory from the stack
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        AllocResult<void> result = try_allocate(bytes, alignment);
+        if (!result) {
+            std::cout << "Stack allocator out of memory! Requested: " << bytes 
+                      << " bytes, available: " << (total_size_ - align_up(current_offset_, alignment)) << " bytes\n";
+            throw_bad_alloc();
+        }
         
-        std::cout << "Allocated " << bytes << " bytes at offset " << aligned_offset 
+        std::cout << "Allocated " << bytes << " bytes at offset " << (static_cast<char*>(*result) - memory_)
                   << " (stack top now at " << current_offset_ << ")\n";
         
-        return ptr;
+        return *result;
     }
     
     // Type-safe allocation template
     template<typename T>
     T* allocate(std::size_t count = 1) {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw_bad_alloc();
+        }
         std::size_t bytes = sizeof(T) * count;
         void* ptr = allocate(bytes, alignof(T));
         return static_cast<T*>(ptr);
@@ -209,6 +245,28 @@ int main() {
         objects[i].~TestObject();
     }
     
+    std::cout << "\n=== Out-of-space demo ===\n";
+    
+    // try_allocate() reports a full stack without throwing, so a caller can
+    // fall back (here: to the heap) instead of unwinding
+    std::size_t before_big = allocator.get_marker();
+    AllocResult<double> big = allocator.try_allocate<double>(1000);
+    if (big) {
+        std::cout << "Unexpectedly fit 1000 doubles\n";
+    } else {
+        std::cout << "try_allocate<double>(1000) failed with " << allocator.get_remaining_size()
+                  << " bytes left; falling back to the heap\n";
+        double* fallback = new double[1000];
+        fallback[999] = 1.0;
+        delete[] fallback;
+    }
+    std::cout << "Stack top unchanged: " << (allocator.get_marker() == before_big ? "yes" : "no") << "\n";
+    
+    // A count whose byte size wraps past SIZE_MAX must fail, not reserve 0 bytes
+    AllocResult<double> wrapped = allocator.try_allocate<double>(SIZE_MAX / sizeof(double) + 1);
+    std::cout << "try_allocate<double>(SIZE_MAX / 8 + 1) " << (wrapped ? "succeeded (wrapped!)" : "failed")
+              << ", stack top unchanged: " << (allocator.get_marker() == before_big ? "yes" : "no") << "\n";
+    
     std::cout << "\n=== Final cleanup ===\n";
     
     // Clear entire allocator
@@ -220,6 +278,7 @@ int main() {
     std::cout << "- Perfect for temporary allocations with predictable lifetimes\n";
     std::cout << "- Remember to manually destroy non-trivial objects!\n";
     std::cout << "- Excellent cache locality due to linear memory layout\n";
+    std::cout << "- try_allocate() lets callers handle a full stack without exceptions\n";
     
     return 0;
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include <iostream>
 #include <memory>
 #include <cstddef>
+#include <cstdlib>
 #include <new>
 
+#include "../common/alloc_result.hpp"
+
 // Shared state for all stack allocator instances
 // This allows different template instantiations to share the same underlying stack
 struct StackState {
@@ -89,7 +92,7 @@ public:
         if (aligned_offset + bytes > state_->total_size_) {
             std::cout << "Stack allocator out of memory! Requested: " << bytes 
                       << " bytes, available: " << (state_->total_size_ - aligned_offset) << " bytes\n";
-            throw std::bad_alloc();
+            throw_bad_alloc();
         }
         
         // Return pointer to the allocated memory
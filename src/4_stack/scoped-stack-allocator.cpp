@@ -0,0 +1,474 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <scoped_allocator>
+#include <string>
+#include <vector>
+
+#include "../common/alloc_result.hpp"
+
+// Nested containers on custom allocators
+// A std::vector<std::string> on StackAllocator<T> only puts the vector's own
+// buffer on the stack - each string still uses std::allocator<char>. Wrapping
+// the outer allocator in std::scoped_allocator_adaptor hands it down to every
+// element that is allocator-aware, so the whole structure lands in one region.
+
+// ===== STACK ALLOCATOR =====
+// Shared state for all stack allocator instances (see basic_stack_traits.cpp)
+struct StackState {
+    char* memory_;
+    std::size_t total_size_;
+    std::size_t current_offset_ = 0;
+
+    explicit StackState(std::size_t size) : memory_(new char[size]), total_size_(size) {}
+    ~StackState() { delete[] memory_; }
+
+    bool owns(const void* p) const {
+        const char* c = static_cast<const char*>(p);
+        return c >= memory_ && c < memory_ + total_size_;
+    }
+};
+
+template<typename T>
+class StackAllocator {
+private:
+    std::shared_ptr<StackState> state_;
+
+    template<typename U>
+    friend class StackAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit StackAllocator(std::size_t size = 1024)
+        : state_(std::make_shared<StackState>(size)) {}
+
+    // Rebind constructor - every type shares the same stack
+    template<typename U>
+    StackAllocator(const StackAllocator<U>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        std::size_t aligned_offset = (state_->current_offset_ + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (aligned_offset + bytes > state_->total_size_) {
+            throw_bad_alloc();
+        }
+        state_->current_offset_ = aligned_offset + bytes;
+        return reinterpret_cast<T*>(state_->memory_ + aligned_offset);
+    }
+
+    // Only the most recent allocation can be given back (LIFO)
+    void deallocate(T* p, std::size_t n) noexcept {
+        char* end = reinterpret_cast<char*>(p) + n * sizeof(T);
+        if (end == state_->memory_ + state_->current_offset_) {
+            state_->current_offset_ = reinterpret_cast<char*>(p) - state_->memory_;
+        }
+    }
+
+    template<typename U>
+    bool operator==(const StackAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template<typename U>
+    bool operator!=(const StackAllocator<U>& other) const noexcept { return state_ != other.state_; }
+
+    std::size_t get_marker() const { return state_->current_offset_; }
+    void free_to_marker(std::size_t marker) { state_->current_offset_ = marker; }
+    std::size_t get_used_size() const { return state_->current_offset_; }
+    bool owns(const void* p) const { return state_->owns(p); }
+};
+
+// ===== ARENA ALLOCATOR =====
+// Growable bump region; individual deallocation is a no-op, reset() frees all
+struct ArenaState {
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::vector<std::size_t> block_sizes_;
+    std::size_t block_size_;
+    std::size_t offset_ = 0;
+
+    explicit ArenaState(std::size_t block_size) : block_size_(block_size) { add_block(block_size); }
+
+    void add_block(std::size_t size) {
+        blocks_.push_back(std::make_unique<char[]>(size));
+        block_sizes_.push_back(size);
+        offset_ = 0;
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        std::size_t aligned_offset = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (aligned_offset + bytes > block_sizes_.back()) {
+            add_block(bytes + alignment > block_size_ ? bytes + alignment : block_size_);
+            aligned_offset = 0;
+        }
+        offset_ = aligned_offset + bytes;
+        return blocks_.back().get() + aligned_offset;
+    }
+
+    void reset() {
+        blocks_.resize(1);
+        block_sizes_.resize(1);
+        offset_ = 0;
+    }
+
+    bool owns(const void* p) const {
+        const char* c = static_cast<const char*>(p);
+        for (std::size_t i = 0; i < blocks_.size(); ++i) {
+            if (c >= blocks_[i].get() && c < blocks_[i].get() + block_sizes_[i]) return true;
+        }
+        return false;
+    }
+};
+
+template<typename T>
+class ArenaAllocator {
+private:
+    std::shared_ptr<ArenaState> state_;
+
+    template<typename U>
+    friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(std::size_t block_size = 64 * 1024)
+        : state_(std::make_shared<ArenaState>(block_size)) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(state_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return state_ != other.state_; }
+
+    void reset() { state_->reset(); }
+    bool owns(const void* p) const { return state_->owns(p); }
+};
+
+// ===== SIZE-CLASS POOL ALLOCATOR =====
+// Strings and vectors ask for many different sizes, so the pool keeps one
+// free list per power-of-two class and sends anything bigger to the heap
+struct PoolState {
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr std::size_t MIN_CLASS = 16;
+    static constexpr std::size_t NUM_CLASSES = 7;  // 16 .. 1024 bytes
+    static constexpr std::size_t CHUNK_BYTES = 64 * 1024;
+
+    FreeNode* free_lists_[NUM_CLASSES] = {};
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t pooled_allocations_ = 0;
+
+    static std::size_t class_index(std::size_t bytes) {
+        std::size_t index = 0;
+        std::size_t size = MIN_CLASS;
+        while (size < bytes) {
+            size <<= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    void refill(std::size_t index) {
+        std::size_t block = MIN_CLASS << index;
+        auto chunk = std::make_unique<char[]>(CHUNK_BYTES);
+        for (std::size_t offset = 0; offset + block <= CHUNK_BYTES; offset += block) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(chunk.get() + offset);
+            node->next = free_lists_[index];
+            free_lists_[index] = node;
+        }
+        chunks_.push_back(std::move(chunk));
+    }
+
+    void* allocate(std::size_t bytes) {
+        std::size_t index = class_index(bytes);
+        if (index >= NUM_CLASSES) {
+            return ::operator new(bytes);
+        }
+        if (!free_lists_[index]) {
+            refill(index);
+        }
+        FreeNode* node = free_lists_[index];
+        free_lists_[index] = node->next;
+        ++pooled_allocations_;
+        return node;
+    }
+
+    void deallocate(void* p, std::size_t bytes) noexcept {
+        std::size_t index = class_index(bytes);
+        if (index >= NUM_CLASSES) {
+            ::operator delete(p);
+            return;
+        }
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_lists_[index];
+        free_lists_[index] = node;
+    }
+};
+
+template<typename T>
+class PoolAllocator {
+private:
+    std::shared_ptr<PoolState> state_;
+
+    template<typename U>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator() : state_(std::make_shared<PoolState>()) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(state_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        state_->deallocate(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept { return state_ != other.state_; }
+
+    std::size_t pooled_allocations() const { return state_->pooled_allocations_; }
+};
+
+// ===== NESTED CONTAINER TYPES =====
+// Every level uses a scoped adaptor so the allocator keeps flowing down
+template<template<typename> class Alloc>
+struct Nested {
+    using String = std::basic_string<char, std::char_traits<char>, Alloc<char>>;
+    using Strings = std::vector<String, std::scoped_allocator_adaptor<Alloc<String>>>;
+    using Table = std::vector<Strings, std::scoped_allocator_adaptor<Alloc<Strings>>>;
+};
+
+// ===== USES-ALLOCATOR HELPERS (no PMR needed) =====
+// Construct a T inside the allocator's region, passing the allocator on to T
+// (and through T to its elements) exactly as a container would
+template<typename T, typename Alloc, typename... Args>
+T* new_using_allocator(const Alloc& alloc, Args&&... args) {
+    using TAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    TAlloc t_alloc(alloc);
+    T* p = std::allocator_traits<TAlloc>::allocate(t_alloc, 1);
+    std::uninitialized_construct_using_allocator(p, alloc, std::forward<Args>(args)...);
+    return p;
+}
+
+template<typename T, typename Alloc>
+void delete_using_allocator(const Alloc& alloc, T* p) {
+    using TAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    TAlloc t_alloc(alloc);
+    p->~T();
+    std::allocator_traits<TAlloc>::deallocate(t_alloc, p, 1);
+}
+
+// ===== CHECKS =====
+// Runtime checks rather than assert(), so Release builds still verify
+int failed_checks = 0;
+
+bool check(bool condition, const char* what) {
+    if (!condition) {
+        ++failed_checks;
+        std::cout << "  FAIL: " << what << "\n";
+    }
+    return condition;
+}
+
+const char* pass_fail(bool ok) { return ok ? "pass" : "FAIL"; }
+
+const char* LONG_TEXT = "a string long enough to skip the small string buffer";
+
+template<typename Table, typename Owner>
+bool everything_in_region(const Table& table, const Owner& owner) {
+    for (const auto& row : table) {
+        if (!owner.owns(row.data())) return false;
+        for (const auto& s : row) {
+            if (!owner.owns(s.data())) return false;
+        }
+    }
+    return true;
+}
+
+void check_stack() {
+    using N = Nested<StackAllocator>;
+    StackAllocator<char> stack(64 * 1024);
+    bool ok = true;
+    std::size_t marker = stack.get_marker();
+    {
+        N::Strings strings(stack);
+        strings.reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            strings.emplace_back(LONG_TEXT);
+        }
+        ok &= check(strings[0].get_allocator() == stack, "string allocator is the stack");
+        for (const auto& s : strings) {
+            ok &= check(stack.owns(s.data()), "string data on the stack");
+        }
+
+        N::Table table(stack);
+        table.resize(3);
+        for (auto& row : table) {
+            row.emplace_back(LONG_TEXT);
+        }
+        ok &= check(everything_in_region(table, stack), "table rows and strings on the stack");
+    }
+    stack.free_to_marker(marker);
+    std::cout << "StackAllocator: inner strings live on the stack: " << pass_fail(ok) << "\n";
+}
+
+void check_arena() {
+    using N = Nested<ArenaAllocator>;
+    ArenaAllocator<char> arena(4096);
+    N::Table table(arena);
+    for (int r = 0; r < 20; ++r) {
+        table.emplace_back();
+        for (int c = 0; c < 10; ++c) {
+            table.back().emplace_back(LONG_TEXT);
+        }
+    }
+    bool ok = check(table[5][5].get_allocator() == arena, "inner string allocator is the arena");
+    ok &= check(everything_in_region(table, arena), "nested table inside the arena");
+
+    // Copying into another container re-homes the copy in that container's arena
+    ArenaAllocator<char> other_arena(4096);
+    N::Table copy(table, other_arena);
+    ok &= check(everything_in_region(copy, other_arena), "copy inside the other arena");
+    std::cout << "ArenaAllocator: nested table and its copy each stay in their own arena: " << pass_fail(ok) << "\n";
+}
+
+void check_pool() {
+    using N = Nested<PoolAllocator>;
+    PoolAllocator<char> pool;
+    N::Strings strings(pool);
+    for (int i = 0; i < 8; ++i) {
+        strings.emplace_back(LONG_TEXT);
+    }
+    // One pooled allocation per string, plus the vector's growth steps
+    bool ok = check(pool.pooled_allocations() >= 8 + 4, "strings and vector growth served by the pool");
+    ok &= check(strings[7].get_allocator() == pool, "inner string allocator is the pool");
+    std::cout << "PoolAllocator: " << pool.pooled_allocations() << " allocations served by the pool: "
+              << pass_fail(ok) << "\n";
+}
+
+void check_helper() {
+    using N = Nested<ArenaAllocator>;
+    ArenaAllocator<char> arena(4096);
+    std::scoped_allocator_adaptor<ArenaAllocator<char>> scoped(arena);
+
+    // The table object itself, its rows and its strings all land in the arena
+    N::Table* table = new_using_allocator<N::Table>(scoped, 3);
+    for (auto& row : *table) {
+        row.emplace_back(LONG_TEXT);
+    }
+    bool ok = check(arena.owns(table), "table object inside the arena");
+    ok &= check(everything_in_region(*table, arena), "rows and strings inside the arena");
+
+    // make_obj_using_allocator builds by value with the same rules
+    auto row = std::make_obj_using_allocator<N::Strings>(scoped, 2, LONG_TEXT);
+    ok &= check(arena.owns(row[1].data()), "make_obj_using_allocator row inside the arena");
+
+    delete_using_allocator(scoped, table);
+    std::cout << "new_using_allocator: whole structure constructed in one region: " << pass_fail(ok) << "\n";
+}
+
+// ===== BENCHMARK =====
+template<typename Table, typename Alloc>
+long long build_and_tear_down(const Alloc& alloc, int rounds, int rows, int columns) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        Table table(alloc);
+        table.reserve(rows);
+        for (int r = 0; r < rows; ++r) {
+            table.emplace_back();
+            table.back().reserve(columns);
+            for (int c = 0; c < columns; ++c) {
+                table.back().emplace_back(LONG_TEXT);
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== scoped_allocator_adaptor with custom allocators ===\n\n";
+
+    check_stack();
+    check_arena();
+    check_pool();
+    check_helper();
+    std::cout << (failed_checks == 0 ? "All checks passed\n" : "Some checks FAILED\n");
+
+    std::cout << "\n=== Benchmark: nested table construction + teardown ===\n";
+    const int ROUNDS = 200;
+    const int ROWS = 100;
+    const int COLUMNS = 20;
+
+    using StdString = std::string;
+    using StdTable = std::vector<std::vector<StdString>>;
+    long long heap_us = build_and_tear_down<StdTable>(std::allocator<char>(), ROUNDS, ROWS, COLUMNS);
+
+    StackAllocator<char> stack(8 * 1024 * 1024);
+    long long stack_us = 0;
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            std::size_t marker = stack.get_marker();
+            build_and_tear_down<Nested<StackAllocator>::Table>(stack, 1, ROWS, COLUMNS);
+            stack.free_to_marker(marker);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        stack_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    }
+
+    ArenaAllocator<char> arena(1024 * 1024);
+    long long arena_us = 0;
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            build_and_tear_down<Nested<ArenaAllocator>::Table>(arena, 1, ROWS, COLUMNS);
+            arena.reset();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        arena_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    }
+
+    PoolAllocator<char> pool;
+    long long pool_us = build_and_tear_down<Nested<PoolAllocator>::Table>(pool, ROUNDS, ROWS, COLUMNS);
+
+    std::cout << ROUNDS << " rounds of a " << ROWS << " x " << COLUMNS << " table of strings\n";
+    std::cout << "std::allocator: " << heap_us << " microseconds\n";
+    std::cout << "Stack:          " << stack_us << " microseconds\n";
+    std::cout << "Arena:          " << arena_us << " microseconds\n";
+    std::cout << "Pool:           " << pool_us << " microseconds\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- scoped_allocator_adaptor passes the allocator to every nested level\n";
+    std::cout << "- Rebinding shared-state allocators keeps all levels in one region\n";
+    std::cout << "- uses-allocator construction works without std::pmr\n";
+
+    return failed_checks == 0 ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ===== STRING INTERNER =====
+// Every distinct string is stored once, back to back, in arena blocks that
+// never move - so the string_views handed out stay valid for the interner's
+// lifetime. A flat open-addressing table of 32-bit ids finds duplicates.
+// Comparing two interned strings is comparing two integers.
+class StringInterner {
+private:
+    struct Block {
+        std::unique_ptr<char[]> memory;
+        std::size_t size;
+    };
+
+    static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+
+    // Arena for the characters
+    std::vector<Block> blocks_;
+    std::size_t block_offset_ = 0;
+    std::size_t block_size_;
+    std::size_t bytes_stored_ = 0;
+
+    // id -> string, plus the hash so rehashing never re-reads the text
+    std::vector<std::string_view> strings_;
+    std::vector<uint32_t> hashes_;
+
+    // Open addressing, linear probing, power-of-two size, load <= 1/2
+    std::vector<uint32_t> slots_;
+    std::size_t mask_;
+
+    static uint32_t hash(std::string_view s) {
+        // Eight bytes per step, then a final mix; keys are short ids and codes
+        uint64_t h = 0x9E3779B97F4A7C15ull ^ s.size();
+        std::size_t i = 0;
+        for (; i + 8 <= s.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, s.data() + i, 8);
+            h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+        }
+        uint64_t tail = 0;
+        if (i < s.size()) {
+            std::memcpy(&tail, s.data() + i, s.size() - i);  // "" may have a null data()
+        }
+        h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+    const char* store(std::string_view s) {
+        if (s.empty()) {
+            return "";  // Nothing to copy, and s.data() may be null
+        }
+        if (blocks_.empty() || block_offset_ + s.size() > blocks_.back().size) {
+            std::size_t size = s.size() > block_size_ ? s.size() : block_size_;
+            blocks_.push_back({std::make_unique<char[]>(size), size});
+            block_offset_ = 0;
+        }
+        char* dst = blocks_.back().memory.get() + block_offset_;
+        std::memcpy(dst, s.data(), s.size());
+        block_offset_ += s.size();
+        bytes_stored_ += s.size();
+        return dst;
+    }
+
+    void grow() {
+        std::vector<uint32_t> bigger(slots_.size() * 2, EMPTY);
+        std::size_t mask = bigger.size() - 1;
+        for (uint32_t id = 0; id < strings_.size(); ++id) {
+            std::size_t i = hashes_[id] & mask;
+            while (bigger[i] != EMPTY) i = (i + 1) & mask;
+            bigger[i] = id;
+        }
+        slots_.swap(bigger);
+        mask_ = mask;
+    }
+
+    // The probe mask needs a power-of-two table; 2 keeps a free slot at load 1/2
+    static std::size_t table_size(std::size_t requested) {
+        std::size_t size = 2;
+        while (size < requested) size *= 2;
+        return size;
+    }
+
+public:
+    explicit StringInterner(std::size_t block_size = 64 * 1024, std::size_t initial_slots = 1024)
+        : block_size_(block_size), slots_(table_size(initial_slots), EMPTY), mask_(slots_.size() - 1) {}
+
+    // Return the id of s, adding it if new
+    uint32_t intern(std::string_view s) {
+        uint32_t h = hash(s);
+        std::size_t i = h & mask_;
+        while (slots_[i] != EMPTY) {
+            uint32_t id = slots_[i];
+            if (hashes_[id] == h && strings_[id] == s) {
+                return id;
+            }
+            i = (i + 1) & mask_;
+        }
+
+        uint32_t id = static_cast<uint32_t>(strings_.size());
+        strings_.emplace_back(store(s), s.size());
+        hashes_.push_back(h);
+        slots_[i] = id;
+
+        if (strings_.size() * 2 > slots_.size()) {
+            grow();
+        }
+        return id;
+    }
+
+    // Look up without inserting; EMPTY when absent
+    uint32_t find(std::string_view s) const {
+        uint32_t h = hash(s);
+        for (std::size_t i = h & mask_; slots_[i] != EMPTY; i = (i + 1) & mask_) {
+            uint32_t id = slots_[i];
+            if (hashes_[id] == h && strings_[id] == s) {
+                return id;
+            }
+        }
+        return EMPTY;
+    }
+
+    std::string_view view(uint32_t id) const { return strings_[id]; }
+
+    std::size_t size() const { return strings_.size(); }
+    static constexpr uint32_t npos() { return EMPTY; }
+
+    // Everything the interner owns
+    std::size_t memory_bytes() const {
+        std::size_t arena = 0;
+        for (const auto& b : blocks_) arena += b.size;
+        return arena + strings_.capacity() * sizeof(std::string_view) +
+               hashes_.capacity() * sizeof(uint32_t) + slots_.capacity() * sizeof(uint32_t);
+    }
+    std::size_t bytes_stored() const { return bytes_stored_; }
+};
+
+// ===== BENCHMARK DATA =====
+const char* CURRENCIES[] = {"USD", "EUR", "GBP", "JPY", "CHF", "CAD", "AUD", "NZD", "SEK", "NOK"};
+const char* FIELDS[] = {"transaction_amount", "transaction_currency", "merchant_identifier",
+                        "merchant_category_code", "card_acceptor_terminal", "authorization_code"};
+
+struct StringRecord {
+    std::string currency;
+    std::string merchant;
+    std::string field;
+};
+
+struct InternedRecord {
+    uint32_t currency;
+    uint32_t merchant;
+    uint32_t field;
+};
+
+// Heap bytes a std::string uses beyond its own object (SSO strings use none)
+std::size_t heap_bytes(const std::string& s) {
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+int main() {
+    std::cout << "=== Arena-backed String Interner ===\n\n";
+
+    StringInterner interner;
+    uint32_t usd = interner.intern("USD");
+    uint32_t eur = interner.intern("EUR");
+    uint32_t usd_again = interner.intern(std::string("US") + "D");
+    std::cout << "USD=" << usd << " EUR=" << eur << " USD again=" << usd_again << "\n";
+    std::cout << "view(" << eur << ") = " << interner.view(eur) << "\n";
+    std::cout << "find(\"GBP\") = " << (interner.find("GBP") == StringInterner::npos() ? "absent" : "present") << "\n";
+
+    // Odd table sizes are rounded up to a power of two; "" interns like any string
+    StringInterner tiny(64, 3);
+    uint32_t empty = tiny.intern(std::string_view());
+    for (const char* c : CURRENCIES) tiny.intern(c);
+    std::cout << "3-slot interner: " << tiny.size() << " strings, \"\" id " << empty << " == "
+              << tiny.intern("") << "\n";
+
+    std::cout << "\n=== Benchmark: 2M transaction records ===\n";
+    const std::size_t RECORDS = 2000000;
+    const std::size_t MERCHANTS = 20000;
+
+    std::vector<std::string> merchant_names;
+    for (std::size_t i = 0; i < MERCHANTS; ++i) {
+        merchant_names.push_back("MERCHANT-ACQUIRER-" + std::to_string(1000000 + i));
+    }
+
+    std::mt19937 rng(7);
+    std::vector<StringRecord> string_records;
+    std::vector<InternedRecord> interned_records;
+    string_records.reserve(RECORDS);
+    interned_records.reserve(RECORDS);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < RECORDS; ++i) {
+        string_records.push_back({CURRENCIES[rng() % 10], merchant_names[rng() % MERCHANTS], FIELDS[rng() % 6]});
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    long long build_strings_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    rng.seed(7);
+    StringInterner records_interner;
+    start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < RECORDS; ++i) {
+        interned_records.push_back({records_interner.intern(CURRENCIES[rng() % 10]),
+                                    records_interner.intern(merchant_names[rng() % MERCHANTS]),
+                                    records_interner.intern(FIELDS[rng() % 6])});
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long build_interned_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::size_t string_bytes = string_records.capacity() * sizeof(StringRecord);
+    for (const auto& r : string_records) {
+        string_bytes += heap_bytes(r.currency) + heap_bytes(r.merchant) + heap_bytes(r.field);
+    }
+    std::size_t interned_bytes = interned_records.capacity() * sizeof(InternedRecord) + records_interner.memory_bytes();
+
+    std::cout << "Build:  std::string " << build_strings_us << " us, interned " << build_interned_us << " us\n";
+    std::cout << "Memory: std::string " << (string_bytes >> 20) << " MB, interned "
+              << (interned_bytes >> 20) << " MB (" << records_interner.size() << " unique strings, "
+              << records_interner.bytes_stored() << " bytes of text)\n";
+
+    // Comparison: count records matching a given merchant and currency
+    const std::string& wanted_merchant = merchant_names[1234];
+    start = std::chrono::high_resolution_clock::now();
+    std::size_t string_matches = 0;
+    for (const auto& r : string_records) {
+        string_matches += (r.merchant == wanted_merchant && r.currency == "EUR");
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long compare_strings_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    uint32_t wanted_id = records_interner.find(wanted_merchant);
+    uint32_t eur_id = records_interner.find("EUR");
+    std::size_t interned_matches = 0;
+    for (const auto& r : interned_records) {
+        interned_matches += (r.merchant == wanted_id && r.currency == eur_id);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long compare_interned_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "Compare: std::string " << compare_strings_us << " us, interned "
+              << compare_interned_us << " us (" << string_matches << " / " << interned_matches << " matches)\n";
+
+    // Keyed aggregation: totals per merchant
+    start = std::chrono::high_resolution_clock::now();
+    std::unordered_map<std::string, std::size_t> by_name;
+    for (const auto& r : string_records) {
+        ++by_name[r.merchant];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long map_strings_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::size_t> by_id(records_interner.size(), 0);  // Ids are dense
+    for (const auto& r : interned_records) {
+        ++by_id[r.merchant];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    long long map_interned_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::cout << "Group by merchant: unordered_map<std::string> " << map_strings_us
+              << " us, vector indexed by id " << map_interned_us << " us\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Each distinct string is stored once, contiguously\n";
+    std::cout << "- Records shrink to three 32-bit ids\n";
+    std::cout << "- Equality and grouping become integer operations\n";
+
+    return 0;
+}
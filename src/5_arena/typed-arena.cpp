@@ -0,0 +1,310 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../common/alloc_result.hpp"
+
+// ===== TYPED ARENA =====
+// Bump allocation plus object lifetimes:
+// - make<T>(args...) constructs one object, make_array<T>(n) constructs n
+// - Trivially destructible types are a pure pointer bump - nothing recorded
+// - Other types push a small destructor record, allocated in the arena
+//   itself; arrays push ONE record covering the whole range
+// - reset() / rewind() run the recorded destructors newest-first
+class TypedArena {
+private:
+    struct DestructorRecord {
+        void (*destroy)(void* first, std::size_t count);
+        void* first;
+        std::size_t count;
+        DestructorRecord* prev;
+    };
+
+    char* memory_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+    DestructorRecord* records_ = nullptr;  // Newest first
+    std::size_t record_count_ = 0;
+
+    template<typename T>
+    static void destroy_range(void* first, std::size_t count) {
+        T* objects = static_cast<T*>(first);
+        for (std::size_t i = count; i > 0; --i) {
+            objects[i - 1].~T();  // Reverse construction order
+        }
+    }
+
+    // Claims room for count objects and, if T needs one, their destructor
+    // record in a single step. Running out of space throws before anything
+    // is constructed, so no object can end up without its record
+    template<typename T>
+    T* bump_with_record(std::size_t count, void*& record_slot) {
+        std::size_t object_offset = (offset_ + alignof(T) - 1) & ~(alignof(T) - 1);
+        std::size_t end = object_offset + sizeof(T) * count;
+        std::size_t record_offset = end;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            record_offset = (end + alignof(DestructorRecord) - 1) & ~(alignof(DestructorRecord) - 1);
+            end = record_offset + sizeof(DestructorRecord);
+        }
+        if (end > size_) {
+            throw_bad_alloc();
+        }
+        offset_ = end;
+        record_slot = memory_ + record_offset;
+        return reinterpret_cast<T*>(memory_ + object_offset);
+    }
+
+    template<typename T>
+    void register_destructor(void* record_slot, T* first, std::size_t count) {
+        records_ = new (record_slot) DestructorRecord{&destroy_range<T>, first, count, records_};
+        ++record_count_;
+    }
+
+    void run_destructors_until(DestructorRecord* stop) {
+        while (records_ != stop) {
+            records_->destroy(records_->first, records_->count);
+            records_ = records_->prev;
+            --record_count_;
+        }
+    }
+
+public:
+    // Marker captures both the offset and the destructor list position
+    struct Marker {
+        std::size_t offset;
+        DestructorRecord* records;
+    };
+
+    explicit TypedArena(std::size_t size) : memory_(new char[size]), size_(size) {}
+
+    ~TypedArena() {
+        reset();
+        delete[] memory_;
+    }
+
+    TypedArena(const TypedArena&) = delete;
+    TypedArena& operator=(const TypedArena&) = delete;
+
+    template<typename T, typename... Args>
+    T* make(Args&&... args) {
+        void* record_slot;
+        T* obj = new (bump_with_record<T>(1, record_slot)) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            register_destructor(record_slot, obj, 1);
+        }
+        return obj;
+    }
+
+    // Every element is constructed from the same args. With no args,
+    // trivially default-constructible types are left uninitialised (like
+    // new T[n]); everything else is value-initialised
+    template<typename T, typename... Args>
+    T* make_array(std::size_t count, const Args&... args) {
+        void* record_slot;
+        T* first = bump_with_record<T>(count, record_slot);
+        if constexpr (std::is_trivially_default_constructible_v<T> && sizeof...(Args) == 0) {
+            // Nothing to run - leave the memory as-is, like new T[n]
+        } else {
+            std::size_t constructed = 0;
+#if defined(__cpp_exceptions)
+            try {
+                for (; constructed < count; ++constructed) {
+                    new (first + constructed) T(args...);
+                }
+            } catch (...) {
+                destroy_range<T>(first, constructed);
+                throw;
+            }
+#else
+            // Constructors cannot throw in this build, so there is nothing to roll back
+            for (; constructed < count; ++constructed) {
+                new (first + constructed) T(args...);
+            }
+#endif
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            register_destructor(record_slot, first, count);
+        }
+        return first;
+    }
+
+    Marker get_marker() const { return {offset_, records_}; }
+
+    // Destroy everything made since the marker, then rewind to it
+    void rewind(const Marker& marker) {
+        run_destructors_until(marker.records);
+        offset_ = marker.offset;
+    }
+
+    void reset() {
+        run_destructors_until(nullptr);
+        offset_ = 0;
+    }
+
+    std::size_t get_bytes_used() const { return offset_; }
+    std::size_t get_destructor_count() const { return record_count_; }
+};
+
+// ===== NAIVE ARENA (for comparison) =====
+// Registers a destructor callback for every object, trivial or not, in a
+// separate std::vector - what people often write first
+class NaiveArena {
+private:
+    char* memory_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+    std::vector<std::pair<void (*)(void*), void*>> destructors_;
+
+public:
+    explicit NaiveArena(std::size_t size) : memory_(new char[size]), size_(size) {}
+    ~NaiveArena() {
+        reset();
+        delete[] memory_;
+    }
+
+    template<typename T, typename... Args>
+    T* make(Args&&... args) {
+        std::size_t aligned_offset = (offset_ + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (aligned_offset + sizeof(T) > size_) throw_bad_alloc();
+        offset_ = aligned_offset + sizeof(T);
+        T* obj = new (memory_ + aligned_offset) T(std::forward<Args>(args)...);
+        destructors_.emplace_back([](void* p) { static_cast<T*>(p)->~T(); }, obj);
+        return obj;
+    }
+
+    void reset() {
+        for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+            it->first(it->second);
+        }
+        destructors_.clear();
+        offset_ = 0;
+    }
+};
+
+// ===== TEST TYPES =====
+struct Vec3 {  // Trivial
+    float x, y, z;
+};
+
+struct Particle {  // Trivially destructible, has a constructor
+    Vec3 position{};
+    Vec3 velocity{1, 0, 0};
+    float life = 1.0f;
+};
+
+struct Label {  // Non-trivial
+    static inline int live = 0;
+    std::string text;
+    explicit Label(const char* t = "label") : text(t) { ++live; }
+    Label(const Label& other) : text(other.text) { ++live; }
+    ~Label() { --live; }
+};
+
+// ===== BENCHMARK =====
+// Per frame: a handful of labels, many vectors and one particle array
+constexpr int FRAMES = 2000;
+constexpr int LABELS = 50;
+constexpr int VECTORS = 500;
+constexpr int PARTICLES = 1000;
+
+long long bench_heap() {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        std::vector<Label*> labels;
+        std::vector<Vec3*> vectors;
+        for (int i = 0; i < LABELS; ++i) labels.push_back(new Label("frame"));
+        for (int i = 0; i < VECTORS; ++i) vectors.push_back(new Vec3{1, 2, 3});
+        Particle* particles = new Particle[PARTICLES];
+        delete[] particles;
+        for (auto* v : vectors) delete v;
+        for (auto* l : labels) delete l;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+long long bench_naive(NaiveArena& arena) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < LABELS; ++i) arena.make<Label>("frame");
+        for (int i = 0; i < VECTORS; ++i) arena.make<Vec3>(Vec3{1, 2, 3});
+        for (int i = 0; i < PARTICLES; ++i) arena.make<Particle>();
+        arena.reset();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+long long bench_typed(TypedArena& arena) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < LABELS; ++i) arena.make<Label>("frame");
+        for (int i = 0; i < VECTORS; ++i) arena.make<Vec3>(Vec3{1, 2, 3});
+        arena.make_array<Particle>(PARTICLES);
+        arena.reset();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Typed Arena (make<T> / make_array<T>) ===\n\n";
+
+    TypedArena arena(1024 * 1024);
+
+    std::cout << "--- Trivial types cost a bump ---\n";
+    arena.make<Vec3>(Vec3{1, 2, 3});
+    arena.make_array<Particle>(100);
+    std::cout << "Used " << arena.get_bytes_used() << " bytes, destructor records: "
+              << arena.get_destructor_count() << "\n";
+
+    std::cout << "\n--- Non-trivial types register destructors ---\n";
+    TypedArena::Marker marker = arena.get_marker();
+    arena.make<Label>("single");
+    Label* labels = arena.make_array<Label>(10, "array");
+    std::cout << "Live labels: " << Label::live << ", destructor records: "
+              << arena.get_destructor_count() << " (one for the whole array)\n";
+    std::cout << "labels[9].text = " << labels[9].text << "\n";
+
+    arena.rewind(marker);
+    std::cout << "After rewind: live labels " << Label::live
+              << ", destructor records " << arena.get_destructor_count() << "\n";
+
+#if defined(__cpp_exceptions)
+    std::cout << "\n--- Out of space ---\n";
+    TypedArena tiny(sizeof(Label) + 8);  // Room for a label but not its record
+    try {
+        tiny.make<Label>("too big");
+    } catch (const std::bad_alloc&) {
+        std::cout << "make<Label> threw bad_alloc before constructing, live labels: " << Label::live << "\n";
+    }
+#endif
+
+    std::cout << "\n=== Benchmark: mixed trivial / non-trivial frames ===\n";
+    NaiveArena naive(2 * 1024 * 1024);
+    TypedArena typed(2 * 1024 * 1024);
+
+    long long heap_us = bench_heap();
+    long long naive_us = bench_naive(naive);
+    long long typed_us = bench_typed(typed);
+
+    std::cout << FRAMES << " frames of " << LABELS << " labels, " << VECTORS
+              << " vectors, " << PARTICLES << " particles\n";
+    std::cout << "new/delete:                     " << heap_us << " microseconds\n";
+    std::cout << "Arena, destructor per object:   " << naive_us << " microseconds\n";
+    std::cout << "Typed arena:                    " << typed_us << " microseconds\n";
+    std::cout << "Live labels at end: " << Label::live << "\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Type traits decide at compile time whether a destructor is needed\n";
+    std::cout << "- One record per array instead of one per element\n";
+    std::cout << "- Markers rewind memory and lifetimes together\n";
+
+    return 0;
+}
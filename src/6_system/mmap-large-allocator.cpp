@@ -0,0 +1,335 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../common/alloc_result.hpp"
+
+// Large Object Allocator - maps big requests straight from the kernel
+// Key characteristics:
+// - Requests above a threshold bypass malloc and go to mmap
+// - Freed mappings are cached by size so the next request reuses pages
+//   that are already faulted in (no page faults, no glibc trim/re-grow)
+// - Growth uses mremap, so the kernel moves page tables instead of us
+//   copying megabytes of data
+class LargeObjectAllocator {
+private:
+    struct CachedMapping {
+        void* address;
+        std::size_t bytes;
+    };
+
+    static constexpr std::size_t MAX_CACHED = 16;
+
+    CachedMapping cache_[MAX_CACHED];  // Recently freed mappings, oldest first
+    std::size_t cached_count_ = 0;
+    std::size_t cached_bytes_ = 0;
+    std::size_t cache_limit_;          // Upper bound on bytes kept mapped while idle
+    std::size_t page_size_;
+
+    // Statistics
+    std::size_t maps_ = 0;
+    std::size_t unmaps_ = 0;
+    std::size_t cache_hits_ = 0;
+    std::size_t remaps_ = 0;
+
+    std::size_t round_to_pages(std::size_t bytes) const {
+        return (bytes + page_size_ - 1) & ~(page_size_ - 1);
+    }
+
+    void* map_pages(std::size_t bytes) {
+        void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw_bad_alloc();
+        }
+        ++maps_;
+        return ptr;
+    }
+
+    void unmap_pages(void* ptr, std::size_t bytes) {
+        ::munmap(ptr, bytes);
+        ++unmaps_;
+    }
+
+    void remove_cached(std::size_t index) {
+        cached_bytes_ -= cache_[index].bytes;
+        for (std::size_t i = index; i + 1 < cached_count_; ++i) {
+            cache_[i] = cache_[i + 1];
+        }
+        --cached_count_;
+    }
+
+    // Find the smallest cached mapping that fits without wasting more than
+    // a quarter of it - reusing a 64MB mapping for a 1MB request would pin
+    // memory we don't need
+    void* take_from_cache(std::size_t bytes) {
+        std::size_t best = MAX_CACHED;
+        for (std::size_t i = 0; i < cached_count_; ++i) {
+            std::size_t size = cache_[i].bytes;
+            if (size >= bytes && size - bytes <= size / 4 &&
+                (best == MAX_CACHED || size < cache_[best].bytes)) {
+                best = i;
+            }
+        }
+        if (best == MAX_CACHED) {
+            return nullptr;
+        }
+
+        void* ptr = cache_[best].address;
+        std::size_t size = cache_[best].bytes;
+        remove_cached(best);
+        ++cache_hits_;
+
+        // Give back the tail we won't use so the mapping matches the request
+        if (size > bytes) {
+            unmap_pages(static_cast<char*>(ptr) + bytes, size - bytes);
+        }
+        return ptr;
+    }
+
+public:
+    static constexpr std::size_t DEFAULT_THRESHOLD = 256 * 1024;
+
+    explicit LargeObjectAllocator(std::size_t cache_limit = 256 * 1024 * 1024)
+        : cache_limit_(cache_limit),
+          page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))) {}
+
+    ~LargeObjectAllocator() {
+        trim();
+    }
+
+    LargeObjectAllocator(const LargeObjectAllocator&) = delete;
+    LargeObjectAllocator& operator=(const LargeObjectAllocator&) = delete;
+
+    // Allocate at least 'bytes' bytes, page aligned
+    void* allocate(std::size_t bytes) {
+        bytes = round_to_pages(bytes);
+        if (void* ptr = take_from_cache(bytes)) {
+            return ptr;
+        }
+        return map_pages(bytes);
+    }
+
+    // Return a mapping - it is cached rather than unmapped when it fits
+    void deallocate(void* ptr, std::size_t bytes) noexcept {
+        if (ptr == nullptr) return;
+        bytes = round_to_pages(bytes);
+
+        if (bytes > cache_limit_) {
+            unmap_pages(ptr, bytes);
+            return;
+        }
+
+        // Evict oldest entries until the new mapping fits the budget
+        while (cached_count_ > 0 &&
+               (cached_count_ == MAX_CACHED || cached_bytes_ + bytes > cache_limit_)) {
+            unmap_pages(cache_[0].address, cache_[0].bytes);
+            remove_cached(0);
+        }
+
+        cache_[cached_count_++] = {ptr, bytes};
+        cached_bytes_ += bytes;
+    }
+
+    // Grow or shrink an existing mapping; the kernel relocates page table
+    // entries instead of copying the contents
+    void* reallocate(void* ptr, std::size_t old_bytes, std::size_t new_bytes) {
+        if (ptr == nullptr) {
+            return allocate(new_bytes);
+        }
+        old_bytes = round_to_pages(old_bytes);
+        new_bytes = round_to_pages(new_bytes);
+        if (old_bytes == new_bytes) {
+            return ptr;
+        }
+
+        void* result = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (result == MAP_FAILED) {
+            throw_bad_alloc();
+        }
+        ++remaps_;
+        return result;
+    }
+
+    // Release every cached mapping back to the OS
+    void trim() noexcept {
+        while (cached_count_ > 0) {
+            unmap_pages(cache_[cached_count_ - 1].address, cache_[cached_count_ - 1].bytes);
+            cached_bytes_ -= cache_[cached_count_ - 1].bytes;
+            --cached_count_;
+        }
+    }
+
+    // Statistics
+    std::size_t get_map_count() const { return maps_; }
+    std::size_t get_unmap_count() const { return unmaps_; }
+    std::size_t get_cache_hits() const { return cache_hits_; }
+    std::size_t get_remap_count() const { return remaps_; }
+    std::size_t get_cached_bytes() const { return cached_bytes_; }
+};
+
+// Standard allocator front end: small requests keep using ::operator new,
+// big ones (the multi-megabyte buffers) go to the shared large allocator
+template<typename T>
+class LargeBufferAllocator {
+public:
+    using value_type = T;
+
+    static LargeObjectAllocator& large_pool() {
+        static LargeObjectAllocator instance;
+        return instance;
+    }
+
+    LargeBufferAllocator() = default;
+
+    template<typename U>
+    LargeBufferAllocator(const LargeBufferAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        if (bytes >= LargeObjectAllocator::DEFAULT_THRESHOLD) {
+            return static_cast<T*>(large_pool().allocate(bytes));
+        }
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        std::size_t bytes = n * sizeof(T);
+        if (bytes >= LargeObjectAllocator::DEFAULT_THRESHOLD) {
+            large_pool().deallocate(p, bytes);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    // Stateless - every instance shares the same large pool
+    template<typename U>
+    bool operator==(const LargeBufferAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const LargeBufferAllocator<U>&) const noexcept { return false; }
+};
+
+// Touch one byte per page so page-fault cost is part of the measurement
+template<typename Buffer>
+void touch_pages(Buffer& buffer) {
+    for (std::size_t i = 0; i < buffer.size(); i += 4096) {
+        buffer[i] = static_cast<char>(i);
+    }
+}
+
+template<typename Alloc>
+long long run_large_buffer_benchmark(std::size_t rounds, std::size_t buffers_per_round,
+                                     std::size_t buffer_bytes) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t round = 0; round < rounds; ++round) {
+        std::vector<std::vector<char, Alloc>> buffers;
+        buffers.reserve(buffers_per_round);
+        for (std::size_t i = 0; i < buffers_per_round; ++i) {
+            buffers.emplace_back(buffer_bytes);
+            touch_pages(buffers.back());
+        }
+    } // All buffers freed here, then re-requested next round
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Large Object Allocator (mmap + mapping cache) ===\n\n";
+
+    LargeObjectAllocator allocator;
+
+    std::cout << "--- Map, free, and reuse ---\n";
+    void* first = allocator.allocate(4 * 1024 * 1024);
+    std::memset(first, 0xAB, 4 * 1024 * 1024);
+    allocator.deallocate(first, 4 * 1024 * 1024);
+
+    void* second = allocator.allocate(4 * 1024 * 1024);
+    std::cout << "Second 4MB request " << (first == second ? "reused" : "did not reuse")
+              << " the cached mapping\n";
+
+    std::cout << "\n--- Growth with mremap ---\n";
+    std::size_t size = 4 * 1024 * 1024;
+    char* growing = static_cast<char*>(second);
+    for (int step = 0; step < 4; ++step) {
+        growing = static_cast<char*>(allocator.reallocate(growing, size, size * 2));
+        size *= 2;
+        growing[size - 1] = 1;
+        std::cout << "Grew to " << (size >> 20) << "MB, first byte still 0x"
+                  << std::hex << (static_cast<unsigned>(growing[0]) & 0xFF) << std::dec << "\n";
+    }
+    allocator.deallocate(growing, size);
+
+    std::cout << "maps=" << allocator.get_map_count()
+              << " unmaps=" << allocator.get_unmap_count()
+              << " cache hits=" << allocator.get_cache_hits()
+              << " remaps=" << allocator.get_remap_count()
+              << " cached=" << (allocator.get_cached_bytes() >> 20) << "MB\n";
+
+    std::cout << "\n=== Benchmark: vector of large buffers ===\n";
+    const std::size_t ROUNDS = 50;
+    const std::size_t BUFFERS = 8;
+    const std::size_t BUFFER_BYTES = 8 * 1024 * 1024;
+
+    long long default_us = run_large_buffer_benchmark<std::allocator<char>>(ROUNDS, BUFFERS, BUFFER_BYTES);
+    long long large_us = run_large_buffer_benchmark<LargeBufferAllocator<char>>(ROUNDS, BUFFERS, BUFFER_BYTES);
+
+    std::cout << ROUNDS << " rounds of " << BUFFERS << " x " << (BUFFER_BYTES >> 20) << "MB buffers\n";
+    std::cout << "Default (::operator new): " << default_us << " microseconds\n";
+    std::cout << "Large object allocator:   " << large_us << " microseconds\n";
+
+    LargeObjectAllocator& shared = LargeBufferAllocator<char>::large_pool();
+    std::cout << "Large allocator maps=" << shared.get_map_count()
+              << " cache hits=" << shared.get_cache_hits() << "\n";
+
+    std::cout << "\n=== Benchmark: growing one buffer to 256MB ===\n";
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::size_t bytes = 1024 * 1024;
+        char* buffer = static_cast<char*>(::operator new(bytes));
+        std::memset(buffer, 1, bytes);
+        while (bytes < 256u * 1024 * 1024) {
+            char* bigger = static_cast<char*>(::operator new(bytes * 2));
+            std::memcpy(bigger, buffer, bytes);
+            std::memset(bigger + bytes, 1, bytes);
+            ::operator delete(buffer);
+            buffer = bigger;
+            bytes *= 2;
+        }
+        ::operator delete(buffer);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "new + memcpy: "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                  << " microseconds\n";
+    }
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::size_t bytes = 1024 * 1024;
+        char* buffer = static_cast<char*>(allocator.allocate(bytes));
+        std::memset(buffer, 1, bytes);
+        while (bytes < 256u * 1024 * 1024) {
+            buffer = static_cast<char*>(allocator.reallocate(buffer, bytes, bytes * 2));
+            std::memset(buffer + bytes, 1, bytes);
+            bytes *= 2;
+        }
+        allocator.deallocate(buffer, bytes);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "mremap:       "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                  << " microseconds\n";
+    }
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Big buffers skip malloc's heap entirely\n";
+    std::cout << "- Cached mappings come back already faulted in\n";
+    std::cout << "- mremap grows a buffer without copying its contents\n";
+
+    return 0;
+}
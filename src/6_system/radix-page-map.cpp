@@ -0,0 +1,320 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+#include <sys/mman.h>
+
+#include "../common/alloc_result.hpp"
+
+// ===== RADIX PAGE MAP =====
+// Maps every 4KB page the allocator owns to a small descriptor. A C-style
+// free(void*) only has the pointer, so it needs this to find the size class.
+// Three levels of 12 bits each cover a 48-bit address space (36 bits of page
+// number). Interior nodes are created on demand; a lookup is three loads.
+class PageMap {
+public:
+    static constexpr unsigned PAGE_SHIFT = 12;
+    static constexpr std::size_t PAGE_SIZE = std::size_t(1) << PAGE_SHIFT;
+
+private:
+    static constexpr unsigned LEVEL_BITS = 12;
+    static constexpr std::size_t LEVEL_SIZE = std::size_t(1) << LEVEL_BITS;
+    static constexpr std::size_t LEVEL_MASK = LEVEL_SIZE - 1;
+
+    struct Leaf {
+        uint32_t entries[LEVEL_SIZE];
+    };
+    struct Mid {
+        Leaf* leaves[LEVEL_SIZE];
+    };
+
+    Mid* root_[LEVEL_SIZE] = {};
+    std::size_t node_bytes_ = 0;
+
+    template<typename Node>
+    Node* new_node() {
+        // Zeroed pages straight from the OS; released only when the map dies
+        void* p = ::mmap(nullptr, sizeof(Node), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw_bad_alloc();
+        node_bytes_ += sizeof(Node);
+        return static_cast<Node*>(p);
+    }
+
+public:
+    PageMap() = default;
+
+    ~PageMap() {
+        for (Mid* mid : root_) {
+            if (!mid) continue;
+            for (Leaf* leaf : mid->leaves) {
+                if (leaf) ::munmap(leaf, sizeof(Leaf));
+            }
+            ::munmap(mid, sizeof(Mid));
+        }
+    }
+
+    PageMap(const PageMap&) = delete;
+    PageMap& operator=(const PageMap&) = delete;
+
+    // Descriptor for every page in [start, start + bytes)
+    void set(const void* start, std::size_t bytes, uint32_t value) {
+        uintptr_t first = reinterpret_cast<uintptr_t>(start) >> PAGE_SHIFT;
+        uintptr_t last = (reinterpret_cast<uintptr_t>(start) + bytes - 1) >> PAGE_SHIFT;
+        for (uintptr_t page = first; page <= last; ++page) {
+            std::size_t i1 = (page >> (2 * LEVEL_BITS)) & LEVEL_MASK;
+            std::size_t i2 = (page >> LEVEL_BITS) & LEVEL_MASK;
+            std::size_t i3 = page & LEVEL_MASK;
+            if (!root_[i1]) root_[i1] = new_node<Mid>();
+            if (!root_[i1]->leaves[i2]) root_[i1]->leaves[i2] = new_node<Leaf>();
+            root_[i1]->leaves[i2]->entries[i3] = value;
+        }
+    }
+
+    // 0 means "not ours"
+    uint32_t get(const void* p) const {
+        uintptr_t page = reinterpret_cast<uintptr_t>(p) >> PAGE_SHIFT;
+        const Mid* mid = root_[(page >> (2 * LEVEL_BITS)) & LEVEL_MASK];
+        if (!mid) return 0;
+        const Leaf* leaf = mid->leaves[(page >> LEVEL_BITS) & LEVEL_MASK];
+        if (!leaf) return 0;
+        return leaf->entries[page & LEVEL_MASK];
+    }
+
+    std::size_t get_node_bytes() const { return node_bytes_; }
+};
+
+// ===== SIZE-CLASS ALLOCATOR =====
+// Small requests are rounded up to one of the size classes and served from
+// per-class free lists carved out of 64KB spans. Large requests get their
+// own mapping. Page map descriptors:
+//   1..NUM_CLASSES          small page, value = size class + 1
+//   LARGE_FLAG | pages      first page of a large mapping
+class SizeClassAllocator {
+public:
+    static constexpr std::size_t NUM_CLASSES = 16;
+    static constexpr std::size_t MAX_SMALL = 2048;
+
+private:
+    static constexpr std::size_t SPAN_BYTES = 64 * 1024;
+    static constexpr uint32_t LARGE_FLAG = 0x80000000u;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr std::size_t CLASS_SIZES[NUM_CLASSES] = {
+        16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1280, 1536, 1792, 2048};
+
+    // Request size -> class, in 16-byte steps
+    uint8_t class_for_size_[MAX_SMALL / 16 + 1];
+    FreeNode* free_lists_[NUM_CLASSES] = {};
+    PageMap page_map_;
+    std::vector<void*> spans_;
+
+    void refill(std::size_t cls) {
+        void* span = ::mmap(nullptr, SPAN_BYTES, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (span == MAP_FAILED) throw_bad_alloc();
+        spans_.push_back(span);
+        page_map_.set(span, SPAN_BYTES, static_cast<uint32_t>(cls + 1));
+
+        std::size_t size = CLASS_SIZES[cls];
+        char* base = static_cast<char*>(span);
+        for (std::size_t offset = (SPAN_BYTES / size) * size; offset >= size; offset -= size) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(base + offset - size);
+            node->next = free_lists_[cls];
+            free_lists_[cls] = node;
+        }
+    }
+
+    std::size_t size_class_index(std::size_t bytes) const {
+        return class_for_size_[(bytes + 15) / 16];
+    }
+
+    void free_small(void* p, std::size_t cls) {
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_lists_[cls];
+        free_lists_[cls] = node;
+    }
+
+public:
+    SizeClassAllocator() {
+        std::size_t cls = 0;
+        for (std::size_t i = 0; i <= MAX_SMALL / 16; ++i) {
+            while (CLASS_SIZES[cls] < i * 16) ++cls;
+            class_for_size_[i] = static_cast<uint8_t>(cls);
+        }
+    }
+
+    ~SizeClassAllocator() {
+        for (void* span : spans_) ::munmap(span, SPAN_BYTES);
+    }
+
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+
+    void* allocate(std::size_t bytes) {
+        if (bytes == 0) bytes = 1;
+        if (bytes > MAX_SMALL) {
+            std::size_t pages = (bytes + PageMap::PAGE_SIZE - 1) >> PageMap::PAGE_SHIFT;
+            void* p = ::mmap(nullptr, pages << PageMap::PAGE_SHIFT, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw_bad_alloc();
+            page_map_.set(p, PageMap::PAGE_SIZE, LARGE_FLAG | static_cast<uint32_t>(pages));
+            return p;
+        }
+        std::size_t cls = size_class_index(bytes);
+        if (!free_lists_[cls]) refill(cls);
+        FreeNode* node = free_lists_[cls];
+        free_lists_[cls] = node->next;
+        return node;
+    }
+
+    // Unsized free: the page map supplies the size class
+    void deallocate(void* p) {
+        if (!p) return;
+        uint32_t desc = page_map_.get(p);
+        // Not ours, or an interior pointer of a large block: nothing to free
+        if (desc == 0) return;
+        if (desc & LARGE_FLAG) {
+            if (reinterpret_cast<uintptr_t>(p) & (PageMap::PAGE_SIZE - 1)) return;
+            std::size_t pages = desc & ~LARGE_FLAG;
+            page_map_.set(p, PageMap::PAGE_SIZE, 0);
+            ::munmap(p, pages << PageMap::PAGE_SHIFT);
+            return;
+        }
+        free_small(p, desc - 1);
+    }
+
+    // Sized free: the caller supplies the size, no map lookup
+    void deallocate(void* p, std::size_t bytes) {
+        if (!p) return;
+        if (bytes > MAX_SMALL) {
+            deallocate(p);
+            return;
+        }
+        free_small(p, size_class_index(bytes == 0 ? 1 : bytes));
+    }
+
+    // Usable size of any pointer we handed out
+    std::size_t usable_size(const void* p) const {
+        uint32_t desc = page_map_.get(p);
+        if (desc & LARGE_FLAG) return std::size_t(desc & ~LARGE_FLAG) << PageMap::PAGE_SHIFT;
+        return desc ? CLASS_SIZES[desc - 1] : 0;
+    }
+
+    bool owns(const void* p) const { return page_map_.get(p) != 0; }
+    std::size_t get_page_map_bytes() const { return page_map_.get_node_bytes(); }
+};
+
+// ===== MALLOC-COMPATIBLE FRONT END =====
+// For C APIs that take ownership of a buffer and call a free(void*) hook
+SizeClassAllocator& global_size_class_allocator() {
+    static SizeClassAllocator instance;
+    return instance;
+}
+
+extern "C" void* sc_malloc(std::size_t bytes) {
+    return global_size_class_allocator().allocate(bytes);
+}
+
+extern "C" void sc_free(void* p) {
+    global_size_class_allocator().deallocate(p);
+}
+
+extern "C" void* sc_realloc(void* p, std::size_t bytes) {
+    if (!p) return sc_malloc(bytes);
+    std::size_t old_size = global_size_class_allocator().usable_size(p);
+    if (bytes <= old_size) return p;
+    void* bigger = sc_malloc(bytes);
+    std::memcpy(bigger, p, old_size);
+    sc_free(p);
+    return bigger;
+}
+
+// ===== BENCHMARK =====
+template<typename Free>
+long long time_frees(const std::vector<void*>& blocks, Free&& free_fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        free_fn(blocks[i], i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Radix Page Map for Unsized Free ===\n\n";
+
+    char* text = static_cast<char*>(sc_malloc(40));
+    std::strcpy(text, "hello from the size-class heap");
+    text = static_cast<char*>(sc_realloc(text, 100));
+    std::cout << text << " (usable size " << global_size_class_allocator().usable_size(text) << ")\n";
+    void* big = sc_malloc(100000);
+    std::cout << "Large block usable size " << global_size_class_allocator().usable_size(big) << "\n";
+    int on_stack = 0;
+    std::cout << "owns(stack variable) = " << global_size_class_allocator().owns(&on_stack) << "\n";
+    sc_free(&on_stack);  // Foreign pointer: ignored
+    sc_free(static_cast<char*>(big) + PageMap::PAGE_SIZE);  // Interior page of a large block: ignored
+    std::cout << "Large block still mapped after bad frees: "
+              << (global_size_class_allocator().usable_size(big) != 0 ? "yes" : "NO") << "\n";
+    sc_free(text);
+    sc_free(big);
+
+    std::cout << "\n=== Benchmark: sized vs unsized free ===\n";
+    const std::size_t COUNT = 2000000;
+    std::mt19937 rng(3);
+    std::vector<std::size_t> sizes(COUNT);
+    for (auto& s : sizes) s = 8 + rng() % 1024;
+
+    SizeClassAllocator allocator;
+    std::vector<void*> blocks(COUNT);
+    std::vector<std::size_t> order(COUNT);
+    for (std::size_t i = 0; i < COUNT; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    auto fill = [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) blocks[i] = allocator.allocate(sizes[i]);
+    };
+    // Free in shuffled order, so neither variant gets sequential addresses
+    std::vector<void*> shuffled(COUNT);
+    std::vector<std::size_t> shuffled_sizes(COUNT);
+    auto shuffle_blocks = [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            shuffled[i] = blocks[order[i]];
+            shuffled_sizes[i] = sizes[order[i]];
+        }
+    };
+
+    fill();
+    shuffle_blocks();
+    long long sized_us = time_frees(shuffled, [&](void* p, std::size_t i) { allocator.deallocate(p, shuffled_sizes[i]); });
+
+    fill();
+    shuffle_blocks();
+    long long unsized_us = time_frees(shuffled, [&](void* p, std::size_t) { allocator.deallocate(p); });
+
+    for (std::size_t i = 0; i < COUNT; ++i) blocks[i] = std::malloc(sizes[i]);
+    shuffle_blocks();
+    long long malloc_us = time_frees(shuffled, [](void* p, std::size_t) { std::free(p); });
+
+    std::cout << COUNT << " frees of 8..1032 byte blocks in random order\n";
+    std::cout << "Sized free (size -> class table): " << sized_us << " microseconds\n";
+    std::cout << "Unsized free (page map lookup):   " << unsized_us << " microseconds\n";
+    std::cout << "glibc free:                       " << malloc_us << " microseconds\n";
+    std::cout << "Page map memory: " << (allocator.get_page_map_bytes() >> 10) << " KB\n";
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- A radix map turns any pointer into its size class in three loads\n";
+    std::cout << "- That is what lets a pool allocator sit behind a C free(void*)\n";
+    std::cout << "- Interior nodes are created on demand, so sparse address spaces stay cheap\n";
+
+    return 0;
+}
@@ -0,0 +1,780 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../common/alloc_result.hpp"
+
+// Global allocator registry with Prometheus text-format export
+// An allocator opts in by embedding an AllocatorMetrics block, which
+// registers itself on construction and unregisters on destruction. This file
+// provides the registry plus three metered allocators that do so
+// (MeteredPool, MeteredArena, MeteredStack); the other demos' allocators are
+// not registered.
+//
+// bytes_in_use is capacity consumed by live allocations, alignment padding
+// and pool block rounding included, so it means the same for every kind.
+// write_prometheus() walks the registry and prints exposition text; a
+// MetricsExporter thread can do that periodically into a file for a
+// textfile scraper (node_exporter's textfile collector, for example).
+//
+// Lock-free with respect to allocation: each counter has a single writer
+// (the allocator that owns it) which updates it with relaxed load + store,
+// no locked instructions and no shared lock. The registry mutex is only
+// taken by register/unregister and by the snapshot, never by allocate().
+//
+// StateDumpWatcher adds an on-demand dump for a bloated process: SIGUSR1
+// sets a flag and pokes a pipe, and a watcher thread writes occupancy,
+// chunk maps and the top size classes to a file. The chunk map is a fixed
+// table behind a seqlock: the allocator writes it on the grow/shrink slow
+// path without waiting for anyone, and the dump retries if it raced a
+// change. A dump never stalls an allocating thread.
+
+// ===== METRICS =====
+class AllocatorMetrics {
+private:
+    std::string name_;
+    const char* kind_;
+    std::size_t size_class_;  // Block size for pools, 0 for variable-size allocators
+
+    std::atomic<uint64_t> bytes_in_use_{0};
+    std::atomic<uint64_t> capacity_bytes_{0};
+    std::atomic<uint64_t> chunks_{0};
+    std::atomic<uint64_t> high_water_bytes_{0};
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> deallocations_{0};
+    std::atomic<uint64_t> failures_{0};
+
+public:
+    static constexpr std::size_t MAX_TRACKED_CHUNKS = 64;
+
+    struct ChunkRange {
+        uintptr_t base;
+        std::size_t bytes;
+    };
+
+private:
+    // Reserved chunks, changed only on the grow/shrink slow path by the
+    // owning allocator. seq_ is odd while a change is in progress; readers
+    // copy the table and retry if seq_ moved. Entries are atomics so the
+    // racing copy is well defined - a torn copy is simply discarded.
+    // Chunks beyond MAX_TRACKED_CHUNKS are counted in chunks_ but not listed.
+    struct ChunkSlot {
+        std::atomic<uintptr_t> base{0};
+        std::atomic<std::size_t> bytes{0};
+    };
+    std::atomic<uint64_t> chunk_seq_{0};
+    std::atomic<std::size_t> chunk_count_{0};
+    ChunkSlot chunk_map_[MAX_TRACKED_CHUNKS];
+
+    void begin_chunk_write() {
+        chunk_seq_.store(chunk_seq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void end_chunk_write() {
+        chunk_seq_.store(chunk_seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Intrusive registry links, guarded by the registry mutex
+    AllocatorMetrics* prev_ = nullptr;
+    AllocatorMetrics* next_ = nullptr;
+    friend class AllocatorRegistry;
+
+    // Single writer: plain load + store, visible to readers without tearing
+    static void add(std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+    static void sub(std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+    }
+
+public:
+    AllocatorMetrics(std::string name, const char* kind, std::size_t size_class = 0);
+    ~AllocatorMetrics();
+
+    AllocatorMetrics(const AllocatorMetrics&) = delete;
+    AllocatorMetrics& operator=(const AllocatorMetrics&) = delete;
+
+    void on_allocate(uint64_t bytes) {
+        add(bytes_in_use_, bytes);
+        add(allocations_, 1);
+        uint64_t in_use = bytes_in_use_.load(std::memory_order_relaxed);
+        if (in_use > high_water_bytes_.load(std::memory_order_relaxed)) {
+            high_water_bytes_.store(in_use, std::memory_order_relaxed);
+        }
+    }
+
+    void on_deallocate(uint64_t bytes) {
+        sub(bytes_in_use_, bytes);
+        add(deallocations_, 1);
+    }
+
+    // Bulk release (arena reset, stack rewind)
+    void on_release(uint64_t bytes) { sub(bytes_in_use_, bytes); }
+
+    void on_failure() { add(failures_, 1); }
+
+    void on_grow(const void* base, uint64_t bytes) {
+        add(capacity_bytes_, bytes);
+        add(chunks_, 1);
+        std::size_t count = chunk_count_.load(std::memory_order_relaxed);
+        if (count == MAX_TRACKED_CHUNKS) return;
+        begin_chunk_write();
+        chunk_map_[count].base.store(reinterpret_cast<uintptr_t>(base), std::memory_order_relaxed);
+        chunk_map_[count].bytes.store(static_cast<std::size_t>(bytes), std::memory_order_relaxed);
+        chunk_count_.store(count + 1, std::memory_order_relaxed);
+        end_chunk_write();
+    }
+
+    void on_shrink(const void* base, uint64_t bytes) {
+        sub(capacity_bytes_, bytes);
+        sub(chunks_, 1);
+        std::size_t count = chunk_count_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (chunk_map_[i].base.load(std::memory_order_relaxed) != reinterpret_cast<uintptr_t>(base)) continue;
+            // Move the last entry into the hole; the dump sorts anyway
+            begin_chunk_write();
+            chunk_map_[i].base.store(chunk_map_[count - 1].base.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+            chunk_map_[i].bytes.store(chunk_map_[count - 1].bytes.load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+            chunk_count_.store(count - 1, std::memory_order_relaxed);
+            end_chunk_write();
+            return;
+        }
+    }
+
+    // Consistent copy of the chunk map; retries while the owner is changing it
+    std::vector<ChunkRange> get_chunk_map() const {
+        std::vector<ChunkRange> copy;
+        copy.reserve(MAX_TRACKED_CHUNKS);
+        while (true) {
+            uint64_t before = chunk_seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            copy.clear();
+            std::size_t count = chunk_count_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < count && i < MAX_TRACKED_CHUNKS; ++i) {
+                copy.push_back({chunk_map_[i].base.load(std::memory_order_relaxed),
+                                chunk_map_[i].bytes.load(std::memory_order_relaxed)});
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (chunk_seq_.load(std::memory_order_relaxed) == before) return copy;
+        }
+    }
+
+    const std::string& get_name() const { return name_; }
+    const char* get_kind() const { return kind_; }
+    std::size_t get_size_class() const { return size_class_; }
+    uint64_t get_bytes_in_use() const { return bytes_in_use_.load(std::memory_order_relaxed); }
+    uint64_t get_capacity_bytes() const { return capacity_bytes_.load(std::memory_order_relaxed); }
+    uint64_t get_chunks() const { return chunks_.load(std::memory_order_relaxed); }
+    uint64_t get_high_water_bytes() const { return high_water_bytes_.load(std::memory_order_relaxed); }
+    uint64_t get_allocations() const { return allocations_.load(std::memory_order_relaxed); }
+    uint64_t get_deallocations() const { return deallocations_.load(std::memory_order_relaxed); }
+    uint64_t get_failures() const { return failures_.load(std::memory_order_relaxed); }
+};
+
+// ===== REGISTRY =====
+class AllocatorRegistry {
+private:
+    std::mutex mutex_;
+    AllocatorMetrics* head_ = nullptr;
+
+    AllocatorRegistry() = default;
+
+public:
+    static AllocatorRegistry& instance() {
+        static AllocatorRegistry registry;
+        return registry;
+    }
+
+    void add(AllocatorMetrics* metrics) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics->next_ = head_;
+        if (head_) head_->prev_ = metrics;
+        head_ = metrics;
+    }
+
+    void remove(AllocatorMetrics* metrics) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (metrics->prev_) metrics->prev_->next_ = metrics->next_;
+        else head_ = metrics->next_;
+        if (metrics->next_) metrics->next_->prev_ = metrics->prev_;
+        metrics->prev_ = metrics->next_ = nullptr;
+    }
+
+    // Visit every live allocator; holds off register/unregister, not allocation
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (AllocatorMetrics* m = head_; m; m = m->next_) fn(*m);
+    }
+};
+
+AllocatorMetrics::AllocatorMetrics(std::string name, const char* kind, std::size_t size_class)
+    : name_(std::move(name)), kind_(kind), size_class_(size_class) {
+    AllocatorRegistry::instance().add(this);
+}
+
+AllocatorMetrics::~AllocatorMetrics() {
+    AllocatorRegistry::instance().remove(this);
+}
+
+// ===== PROMETHEUS EXPORT =====
+std::string escape_label(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+void write_prometheus(std::ostream& out) {
+    struct Row {
+        std::string labels;
+        uint64_t values[7];
+    };
+
+    // Copy the counters first so each metric family prints consistent rows
+    std::vector<Row> rows;
+    AllocatorRegistry::instance().for_each([&](const AllocatorMetrics& m) {
+        rows.push_back({"{name=\"" + escape_label(m.get_name()) + "\",kind=\"" + m.get_kind() + "\"}",
+                        {m.get_bytes_in_use(), m.get_capacity_bytes(), m.get_chunks(), m.get_high_water_bytes(),
+                         m.get_allocations(), m.get_deallocations(), m.get_failures()}});
+    });
+
+    static const struct {
+        const char* name;
+        const char* type;
+        const char* help;
+    } families[7] = {
+        {"allocator_bytes_in_use", "gauge", "Bytes currently handed out to callers, padding included"},
+        {"allocator_capacity_bytes", "gauge", "Bytes reserved from the system"},
+        {"allocator_chunks", "gauge", "Chunks or blocks currently reserved"},
+        {"allocator_high_water_bytes", "gauge", "Highest bytes_in_use seen"},
+        {"allocator_allocations_total", "counter", "Successful allocations"},
+        {"allocator_deallocations_total", "counter", "Deallocations"},
+        {"allocator_failures_total", "counter", "Allocation requests that could not be satisfied"},
+    };
+
+    for (int f = 0; f < 7; ++f) {
+        out << "# HELP " << families[f].name << " " << families[f].help << "\n";
+        out << "# TYPE " << families[f].name << " " << families[f].type << "\n";
+        for (const Row& row : rows) {
+            out << families[f].name << row.labels << " " << row.values[f] << "\n";
+        }
+    }
+}
+
+// Write to a temporary file and rename, so a scraper never reads half a file
+bool dump_prometheus_file(const std::string& path) {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) return false;
+        write_prometheus(out);
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// Optional background thread that refreshes the file every interval
+class MetricsExporter {
+private:
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    uint64_t dumps_ = 0;
+    std::thread thread_;  // Last: starts once everything above is constructed
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            lock.unlock();
+            dump_prometheus_file(path_);
+            lock.lock();
+            ++dumps_;
+            wake_.wait_for(lock, interval_, [this] { return stopping_; });
+        }
+    }
+
+public:
+    MetricsExporter(std::string path, std::chrono::milliseconds interval)
+        : path_(std::move(path)), interval_(interval), thread_([this] { run(); }) {}
+
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+        dump_prometheus_file(path_);  // Final state on shutdown
+    }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    uint64_t get_dumps() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dumps_;
+    }
+};
+
+// ===== STATE DUMP =====
+// Human-readable dump: per-allocator occupancy and chunk map, then size
+// classes ranked by bytes in use across all pools
+void write_state_dump(std::ostream& out) {
+    std::time_t now = std::time(nullptr);
+    char when[32];
+    std::tm local {};
+    localtime_r(&now, &local);  // Runs on the watcher thread
+    std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &local);
+    out << "=== allocator state dump, pid " << getpid() << ", " << when << " ===\n";
+
+    struct ClassTotal {
+        uint64_t bytes_in_use = 0;
+        uint64_t capacity = 0;
+        int allocators = 0;
+    };
+    std::map<std::size_t, ClassTotal> classes;
+    uint64_t total_in_use = 0;
+    uint64_t total_capacity = 0;
+
+    AllocatorRegistry::instance().for_each([&](const AllocatorMetrics& m) {
+        uint64_t in_use = m.get_bytes_in_use();
+        uint64_t capacity = m.get_capacity_bytes();
+        total_in_use += in_use;
+        total_capacity += capacity;
+
+        out << "\n[" << m.get_kind() << "] " << m.get_name();
+        if (m.get_size_class()) out << " (" << m.get_size_class() << "-byte blocks)";
+        out << "\n  occupancy: " << in_use << " / " << capacity << " bytes";
+        if (capacity) out << " (" << std::fixed << std::setprecision(1) << 100.0 * in_use / capacity << "%)";
+        out << ", high water " << m.get_high_water_bytes() << ", failures " << m.get_failures() << "\n";
+
+        auto chunks = m.get_chunk_map();
+        std::sort(chunks.begin(), chunks.end(),
+                  [](const auto& a, const auto& b) { return a.base < b.base; });
+        out << "  chunks: " << m.get_chunks();
+        if (m.get_chunks() > chunks.size()) out << " (" << chunks.size() << " listed)";
+        if (!chunks.empty()) {
+            uintptr_t span = chunks.back().base + chunks.back().bytes - chunks.front().base;
+            out << " spread over " << span / 1024 << " KB of address space";
+        }
+        out << "\n";
+        for (const auto& c : chunks) {
+            out << "    0x" << std::hex << c.base << "-0x" << c.base + c.bytes << std::dec << "  " << c.bytes / 1024
+                << " KB\n";
+        }
+
+        if (m.get_size_class()) {
+            ClassTotal& total = classes[m.get_size_class()];
+            total.bytes_in_use += in_use;
+            total.capacity += capacity;
+            ++total.allocators;
+        }
+    });
+
+    std::vector<std::pair<std::size_t, ClassTotal>> ranked(classes.begin(), classes.end());
+    std::sort(ranked.begin(), ranked.end(),
+              [](const auto& a, const auto& b) { return a.second.bytes_in_use > b.second.bytes_in_use; });
+    out << "\nTop size classes by bytes in use:\n";
+    for (std::size_t i = 0; i < ranked.size() && i < 10; ++i) {
+        out << "  " << std::setw(6) << ranked[i].first << " B: " << ranked[i].second.bytes_in_use << " in use, "
+            << ranked[i].second.capacity << " reserved, " << ranked[i].second.allocators << " pool(s)\n";
+    }
+    out << "\nTotal: " << total_in_use << " bytes in use of " << total_capacity << " reserved\n";
+}
+
+// SIGUSR1 -> flag + one byte down a pipe -> watcher thread writes the dump.
+// The handler only does async-signal-safe work; everything else happens on
+// the watcher thread. One watcher per process.
+class StateDumpWatcher {
+private:
+    static inline std::atomic<bool> dump_requested_{false};
+    static inline int signal_pipe_write_ = -1;
+    static_assert(std::atomic<bool>::is_always_lock_free, "flag is set from a signal handler");
+
+    std::string path_;
+    int pipe_[2] = {-1, -1};
+    struct sigaction previous_ {};
+    std::atomic<uint64_t> dumps_{0};
+    std::thread thread_;
+
+    static void handle_signal(int) {
+        int saved_errno = errno;
+        dump_requested_.store(true, std::memory_order_relaxed);
+        char byte = 'd';
+        ssize_t ignored = write(signal_pipe_write_, &byte, 1);  // Pipe full: a dump is already pending
+        (void)ignored;
+        errno = saved_errno;
+    }
+
+    void run() {
+        char byte;
+        while (true) {
+            ssize_t n = read(pipe_[0], &byte, 1);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0 || byte == 'q') break;
+            if (!dump_requested_.exchange(false, std::memory_order_relaxed)) continue;
+            std::string tmp = path_ + ".tmp";
+            {
+                std::ofstream out(tmp, std::ios::trunc);
+                write_state_dump(out);
+            }
+            std::rename(tmp.c_str(), path_.c_str());
+            dumps_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+public:
+    explicit StateDumpWatcher(std::string path) : path_(std::move(path)) {
+        if (pipe(pipe_) != 0) {
+            std::perror("pipe");  // The watcher cannot work without it
+            std::abort();
+        }
+        fcntl(pipe_[1], F_SETFL, fcntl(pipe_[1], F_GETFL) | O_NONBLOCK);
+        signal_pipe_write_ = pipe_[1];
+        thread_ = std::thread([this] { run(); });
+
+        struct sigaction action {};
+        action.sa_handler = handle_signal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &action, &previous_);
+    }
+
+    ~StateDumpWatcher() {
+        sigaction(SIGUSR1, &previous_, nullptr);
+        char quit = 'q';
+        while (write(pipe_[1], &quit, 1) < 0 && errno == EAGAIN) std::this_thread::yield();
+        thread_.join();
+        signal_pipe_write_ = -1;
+        close(pipe_[0]);
+        close(pipe_[1]);
+    }
+
+    StateDumpWatcher(const StateDumpWatcher&) = delete;
+    StateDumpWatcher& operator=(const StateDumpWatcher&) = delete;
+
+    uint64_t get_dumps() const { return dumps_.load(std::memory_order_acquire); }
+
+    // Wait until at least `count` dumps have been written, or give up
+    bool wait_for_dumps(uint64_t count, std::chrono::milliseconds timeout) const {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (get_dumps() < count) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+// ===== METERED ALLOCATORS =====
+// Fixed-size block pool that grows chunk by chunk up to a limit
+class MeteredPool {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    std::size_t block_size_;
+    std::size_t blocks_per_chunk_;
+    std::size_t max_chunks_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    FreeNode* free_head_ = nullptr;
+    AllocatorMetrics metrics_;
+
+    bool grow() {
+        if (chunks_.size() == max_chunks_) return false;
+        std::size_t bytes = block_size_ * blocks_per_chunk_;
+        chunks_.push_back(std::make_unique<char[]>(bytes));
+        char* chunk = chunks_.back().get();
+        for (std::size_t i = blocks_per_chunk_; i > 0; --i) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(chunk + (i - 1) * block_size_);
+            node->next = free_head_;
+            free_head_ = node;
+        }
+        metrics_.on_grow(chunk, bytes);
+        return true;
+    }
+
+public:
+    MeteredPool(std::string name, std::size_t block_size, std::size_t blocks_per_chunk, std::size_t max_chunks)
+        : block_size_((block_size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1)),
+          blocks_per_chunk_(blocks_per_chunk),
+          max_chunks_(max_chunks),
+          metrics_(std::move(name), "pool", block_size_) {}
+
+    void* allocate() {
+        if (!free_head_ && !grow()) {
+            metrics_.on_failure();
+            return nullptr;
+        }
+        FreeNode* node = free_head_;
+        free_head_ = node->next;
+        metrics_.on_allocate(block_size_);
+        return node;
+    }
+
+    void deallocate(void* p) {
+        FreeNode* node = static_cast<FreeNode*>(p);
+        node->next = free_head_;
+        free_head_ = node;
+        metrics_.on_deallocate(block_size_);
+    }
+};
+
+// Arena made of fixed-size blocks; reset keeps the first block
+class MeteredArena {
+private:
+    std::size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    std::size_t offset_ = 0;
+    std::size_t used_ = 0;
+    AllocatorMetrics metrics_;
+
+    void add_block() {
+        blocks_.push_back(std::make_unique<char[]>(block_size_));
+        offset_ = 0;
+        metrics_.on_grow(blocks_.back().get(), block_size_);
+    }
+
+public:
+    MeteredArena(std::string name, std::size_t block_size) : block_size_(block_size), metrics_(std::move(name), "arena") {
+        add_block();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        if (bytes > block_size_) {
+            metrics_.on_failure();
+            return nullptr;
+        }
+        std::size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes > block_size_) {
+            add_block();
+            aligned = 0;
+        }
+        // Padding included, like MeteredStack
+        std::size_t consumed = aligned + bytes - offset_;
+        offset_ = aligned + bytes;
+        used_ += consumed;
+        metrics_.on_allocate(consumed);
+        return blocks_.back().get() + aligned;
+    }
+
+    void reset() {
+        metrics_.on_release(used_);
+        while (blocks_.size() > 1) {
+            metrics_.on_shrink(blocks_.back().get(), block_size_);
+            blocks_.pop_back();
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+};
+
+// Fixed-size LIFO stack with markers
+class MeteredStack {
+private:
+    std::unique_ptr<char[]> memory_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+    AllocatorMetrics metrics_;
+
+public:
+    MeteredStack(std::string name, std::size_t size)
+        : memory_(std::make_unique<char[]>(size)), size_(size), metrics_(std::move(name), "stack") {
+        metrics_.on_grow(memory_.get(), size);
+    }
+
+    // nullptr when full; the failure is still counted
+    void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        std::size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes > size_) {
+            metrics_.on_failure();
+            return nullptr;
+        }
+        metrics_.on_allocate(aligned + bytes - offset_);
+        offset_ = aligned + bytes;
+        return memory_.get() + aligned;
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        void* p = try_allocate(bytes, alignment);
+        if (!p) throw_bad_alloc();
+        return p;
+    }
+
+    std::size_t get_marker() const { return offset_; }
+
+    void free_to_marker(std::size_t marker) {
+        metrics_.on_release(offset_ - marker);
+        offset_ = marker;
+    }
+};
+
+// ===== BENCHMARK =====
+long long pool_churn(MeteredPool& pool, std::size_t rounds) {
+    void* live[256];
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (auto& p : live) p = pool.allocate();
+        for (auto& p : live) pool.deallocate(p);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Allocator Registry + Prometheus Export ===\n\n";
+
+    MeteredPool orders("orders", 64, 1024, 4);
+    MeteredArena request_scratch("request_scratch", 64 * 1024);
+    MeteredStack frame_stack("frame_stack", 16 * 1024);
+
+    // Some activity, including a failure of each kind
+    std::vector<void*> order_blocks;
+    while (void* p = orders.allocate()) order_blocks.push_back(p);
+    for (std::size_t i = 0; i < order_blocks.size() / 2; ++i) orders.deallocate(order_blocks[i]);
+
+    for (int i = 0; i < 100; ++i) request_scratch.allocate(1500);
+    request_scratch.allocate(1 << 20);  // Larger than a block: fails
+    request_scratch.reset();
+    for (int i = 0; i < 10; ++i) request_scratch.allocate(512);
+
+    std::size_t marker = frame_stack.get_marker();
+    frame_stack.allocate(4096);
+    frame_stack.allocate(8192);
+    if (!frame_stack.try_allocate(8192)) {
+        std::cout << "frame_stack overflow recorded as a failure\n";
+    }
+    frame_stack.free_to_marker(marker);
+    frame_stack.allocate(1024);
+
+    {
+        MeteredPool temporary("short_lived", 32, 64, 1);
+        temporary.allocate();
+        // Registered only while it exists
+    }
+
+    std::cout << "\n--- write_prometheus() ---\n";
+    write_prometheus(std::cout);
+
+    std::cout << "\n--- SIGUSR1 state dump ---\n";
+    const std::string DUMP_PATH = "allocator_state.txt";
+    {
+        StateDumpWatcher watcher(DUMP_PATH);
+        std::cout << "Watcher installed; from a shell: kill -USR1 " << getpid() << "\n";
+        kill(getpid(), SIGUSR1);
+        if (watcher.wait_for_dumps(1, std::chrono::seconds(2))) {
+            std::ifstream in(DUMP_PATH);
+            std::cout << in.rdbuf();
+        } else {
+            std::cout << "No dump written\n";
+        }
+    }
+    std::remove(DUMP_PATH.c_str());
+
+    std::cout << "\n=== Benchmark: 256 allocations + frees x 20000 rounds ===\n";
+    const std::size_t ROUNDS = 20000;
+    const std::string PATH = "allocator_metrics.prom";
+
+    MeteredPool hot("hot_path", 64, 4096, 1);
+    long long quiet_us = pool_churn(hot, ROUNDS);
+
+    long long busy_us;
+    uint64_t dumps;
+    {
+        MetricsExporter exporter(PATH, std::chrono::milliseconds(1));
+        busy_us = pool_churn(hot, ROUNDS);
+        dumps = exporter.get_dumps();
+    }
+
+    long long watched_us;
+    long long signalled_us;
+    uint64_t state_dumps;
+    {
+        StateDumpWatcher watcher(DUMP_PATH);
+        watched_us = pool_churn(hot, ROUNDS);
+
+        std::atomic<bool> done{false};
+        std::thread signaller([&] {
+            while (!done.load()) {
+                kill(getpid(), SIGUSR1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        signalled_us = pool_churn(hot, ROUNDS);
+        done.store(true);
+        signaller.join();
+        state_dumps = watcher.get_dumps();
+    }
+    std::remove(DUMP_PATH.c_str());
+
+    const int SNAPSHOTS = 1000;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < SNAPSHOTS; ++i) {
+        std::ostringstream sink;
+        write_prometheus(sink);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double snapshot_us =
+        std::chrono::duration<double, std::micro>(end - start).count() / SNAPSHOTS;
+
+    std::cout << "Allocation loop, no exporter:          " << quiet_us << " microseconds\n";
+    std::cout << "Allocation loop, exporter every 1 ms:  " << busy_us << " microseconds (" << dumps
+              << " files written meanwhile)\n";
+    std::cout << "Allocation loop, SIGUSR1 watcher idle: " << watched_us << " microseconds\n";
+    std::cout << "Allocation loop, SIGUSR1 every 1 ms:   " << signalled_us << " microseconds (" << state_dumps
+              << " state dumps written)\n";
+    std::size_t registered = 0;
+    AllocatorRegistry::instance().for_each([&](const AllocatorMetrics&) { ++registered; });
+    std::cout << "One snapshot of " << registered << " allocators:        " << snapshot_us << " microseconds\n";
+
+    std::remove(PATH.c_str());
+
+    std::cout << "\nKey takeaways:\n";
+    std::cout << "- Counters live next to each allocator; updates are plain relaxed stores\n";
+    std::cout << "- The registry lock only serializes register/unregister and snapshots\n";
+    std::cout << "- Write-then-rename keeps the scraped file consistent\n";
+    std::cout << "- A signal only sets a flag; the watcher thread does the dump off the hot path\n";
+
+    return 0;
+}
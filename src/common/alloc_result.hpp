@@ -0,0 +1,62 @@
+#pragma once
+
+// Failure reporting shared by the demo allocators:
+// - throw_bad_alloc() for the throwing allocate() paths
+// - BasicAllocResult<T, Error> for the exception-free try_allocate() paths
+// Each demo declares its own AllocError enum and aliases
+// AllocResult<T> = BasicAllocResult<T, AllocError>.
+
+#include <cstdlib>
+#include <new>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+// Throws std::bad_alloc; builds with -fno-exceptions abort instead
+[[noreturn]] inline void throw_bad_alloc() {
+#if defined(__cpp_exceptions)
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif
+}
+
+// std::expected<T*, Error> when the standard library has it (C++23).
+// Otherwise a stand-in with the same has_value() / operator* / error()
+// surface, holding nullptr on failure. The CMake build uses C++20, so it gets
+// the stand-in; compile with -std=c++23 to use std::expected.
+#if defined(__cpp_lib_expected)
+template<typename T, typename Error>
+using BasicAllocResult = std::expected<T*, Error>;
+
+template<typename Error>
+std::unexpected<Error> alloc_failure(Error error) { return std::unexpected(error); }
+
+constexpr const char* ALLOC_RESULT_KIND = "std::expected<T*, AllocError>";
+#else
+template<typename Error>
+struct AllocFailure {
+    Error error;
+};
+
+template<typename T, typename Error>
+class BasicAllocResult {
+private:
+    T* ptr_ = nullptr;
+    Error error_{};
+
+public:
+    BasicAllocResult(T* ptr) noexcept : ptr_(ptr) {}
+    BasicAllocResult(AllocFailure<Error> failure) noexcept : error_(failure.error) {}
+
+    bool has_value() const noexcept { return ptr_ != nullptr; }
+    explicit operator bool() const noexcept { return has_value(); }
+    T* operator*() const noexcept { return ptr_; }
+    Error error() const noexcept { return error_; }
+};
+
+template<typename Error>
+AllocFailure<Error> alloc_failure(Error error) { return {error}; }
+
+constexpr const char* ALLOC_RESULT_KIND = "AllocResult stand-in (std::expected needs C++23)";
+#endif